@@ -1,4 +1,17 @@
 <?xml version="1.0" encoding="UTF-8"?>
 <tileset version="1.10" tiledversion="1.11.2" name="ts_main" tilewidth="32" tileheight="32" tilecount="5" columns="5">
+ <properties>
+  <property name="debugOnly" type="bool" value="true"/>
+ </properties>
  <image source="../tilesets/ts_main.png" width="160" height="32"/>
+ <tile id="0" type="start"/>
+ <tile id="1" type="finish"/>
+ <tile id="2" type="wall"/>
+ <tile id="3" type="platform"/>
+ <tile id="4" type="spikes">
+  <properties>
+   <property name="hazardInsetX" type="int" value="4"/>
+   <property name="hazardInsetTop" type="int" value="10"/>
+  </properties>
+ </tile>
 </tileset>
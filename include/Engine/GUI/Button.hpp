@@ -9,7 +9,7 @@ public:
   void select(bool selected);
   void setPosition(sf::Vector2f position);
   bool contains(sf::Vector2f point) const;
-  void render(sf::RenderWindow &window);
+  void render(sf::RenderTarget &window);
 
 private:
   sf::Text mText;
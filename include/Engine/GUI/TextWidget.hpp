@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Fixed-capacity text buffer for formatting numbers without allocating.
+// Text past the capacity is cut off.
+class TextFormatter {
+public:
+  static constexpr size_t CAPACITY = 128;
+
+  TextFormatter &operator<<(std::string_view str);
+  TextFormatter &operator<<(int value);
+
+  // Fixed-point number with the given number of decimals
+  TextFormatter &fixed(float value, int decimals);
+
+  void clear() { mSize = 0; }
+  std::string_view view() const { return {mData, mSize}; }
+
+private:
+  char mData[CAPACITY];
+  size_t mSize = 0;
+};
+
+// Retained text label. Glyph quads are built only when the text changes and
+// recolored only when the color changes; moving it is free.
+class TextWidget {
+public:
+  TextWidget(const sf::Font &font, unsigned characterSize,
+             float outlineThickness = 0.f);
+
+  // Returns true if the text changed (and the geometry was rebuilt)
+  bool setText(std::string_view text);
+  void setColor(sf::Color color);
+  void setPosition(sf::Vector2f position) { mPosition = position; }
+
+  sf::Vector2f getPosition() const { return mPosition; }
+  // Local bounds of the glyphs (relative to the position)
+  sf::FloatRect getLocalBounds() const { return mBounds; }
+
+  void render(sf::RenderTarget &target) const;
+
+private:
+  void rebuild();
+
+  const sf::Font &mFont;
+  unsigned mCharacterSize;
+  float mOutlineThickness;
+  sf::Color mColor = sf::Color::White;
+  sf::Vector2f mPosition;
+
+  std::string mText;
+  std::vector<sf::Vertex> mVertices;
+  size_t mOutlineVertices = 0; // outline quads come first
+  sf::FloatRect mBounds;
+};
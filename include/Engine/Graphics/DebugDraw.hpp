@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string_view>
+#include <vector>
+
+// Queue of debug primitives (rects, lines, circles, text labels).
+// Anything can add primitives during update and render; flush() draws the
+// whole queue as one triangle list with a single draw call and empties it.
+// Shapes sample the white texels every SFML font page reserves, so they
+// share the label font's texture.
+class DebugDraw {
+public:
+  // Font and size of text labels. Without a font labels are dropped and
+  // shapes are drawn untextured.
+  void setFont(const sf::Font &labelFont, unsigned size = 12);
+
+  // Axis-aligned rectangle with an optional outline (drawn inside the rect)
+  void rect(const sf::FloatRect &bounds, sf::Color fill,
+            sf::Color outline = sf::Color::Transparent,
+            float outlineThickness = 1.f);
+
+  void line(sf::Vector2f from, sf::Vector2f to, sf::Color color,
+            float thickness = 1.f);
+
+  void circle(sf::Vector2f center, float radius, sf::Color color,
+              int segments = 16);
+
+  // Text label (UTF-8), top-left at position
+  void text(sf::Vector2f position, std::string_view str, sf::Color color);
+
+  // Draws and clears the queue
+  void flush(sf::RenderTarget &target,
+             const sf::RenderStates &states = sf::RenderStates::Default);
+
+  // Drops the queue without drawing it
+  void clear() { vertices.clear(); }
+
+  bool empty() const { return vertices.empty(); }
+
+private:
+  void quad(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d,
+            sf::Color color);
+
+  std::vector<sf::Vertex> vertices;
+  const sf::Font *font = nullptr;
+  unsigned characterSize = 12;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Opens every font file once and shares it between all users.
+// SFML rasterizes glyphs lazily on first draw; prewarm() does that work up
+// front for the character sizes a screen is going to use.
+class FontCache {
+public:
+  // Character size and outline thickness drawn with a font
+  struct GlyphSize {
+    unsigned characterSize;
+    float outlineThickness = 0.f;
+  };
+
+  // Printable ASCII, the glyphs our UI and map hints use
+  static const std::u32string DEFAULT_GLYPHS;
+
+  // Font loaded from filename, opened on first use. A font that fails to
+  // open is kept empty so callers can still construct sf::Text with it.
+  const sf::Font &get(const std::string &filename);
+
+  // True if filename was opened successfully
+  bool isLoaded(const std::string &filename);
+
+  // Rasterizes glyphs at each size (fill, plus outline if it has one)
+  void prewarm(const std::string &filename,
+               std::initializer_list<GlyphSize> sizes,
+               const std::u32string &glyphs = DEFAULT_GLYPHS);
+
+private:
+  struct Entry {
+    std::unique_ptr<sf::Font> font;
+    bool loaded = false;
+  };
+
+  Entry &load(const std::string &filename);
+
+  std::unordered_map<std::string, Entry> fonts;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Queue of textured sprites (player, monsters, crates, particles).
+// Entities submit their sprites during render; flush() sorts the queue by
+// layer, then texture, and draws each run of sprites sharing a texture as
+// one triangle list. With an atlas that is a single draw call per frame.
+// Within a layer and texture, sprites keep their submission order.
+class SpriteBatch {
+public:
+  // Queues textureRect of texture. The sprite spans (0, 0) to the rect size
+  // in local space and is placed by transform. flipX and flipY mirror the
+  // image inside that area. Lower layers are drawn first.
+  void draw(const sf::Texture &texture, const sf::IntRect &textureRect,
+            const sf::Transform &transform,
+            sf::Color color = sf::Color::White, int layer = 0,
+            bool flipX = false, bool flipY = false);
+
+  // Draws and clears the queue
+  void flush(sf::RenderTarget &target,
+             const sf::RenderStates &states = sf::RenderStates::Default);
+
+  // Drops the queue without drawing it
+  void clear();
+
+  bool empty() const { return sprites.empty(); }
+
+private:
+  struct Sprite {
+    const sf::Texture *texture;
+    int layer;
+    uint32_t firstVertex; // in queued
+  };
+
+  std::vector<Sprite> sprites;
+  std::vector<sf::Vertex> queued; // submission order
+  std::vector<sf::Vertex> sorted; // draw order, reused every flush
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string_view>
+#include <vector>
+
+// Builds sf::Text-style glyph quads (two triangles each) into a caller-owned
+// vertex buffer, so many texts sharing a font page can be drawn together.
+// Draw the result with font.getTexture(characterSize).
+
+// Appends the quad of a glyph at pen position pos
+void appendGlyphQuad(std::vector<sf::Vertex> &vertices, sf::Vector2f pos,
+                     sf::Color color, const sf::Glyph &glyph);
+
+// Appends the glyphs of a UTF-8 string laid out like sf::Text at position
+// (top-left). With an outline, all outline quads come before the fill
+// quads. Returns the bounds of the appended quads.
+sf::FloatRect appendText(std::vector<sf::Vertex> &vertices,
+                         const sf::Font &font, std::string_view str,
+                         unsigned characterSize, sf::Vector2f position,
+                         sf::Color fillColor, float outlineThickness = 0.f,
+                         sf::Color outlineColor = sf::Color::Black);
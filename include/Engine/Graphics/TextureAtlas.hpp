@@ -0,0 +1,63 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// Packs many images into a few large textures (pages) so sprites and tiles
+// from different files can share one draw call.
+// Images are queued with add() and packed by build() using a shelf packer.
+// Every image gets PADDING pixels of its own edge color around it, so
+// filtering and rounding never pick up texels of a neighbor.
+class TextureAtlas {
+public:
+  // Border around each packed image (pixels)
+  static constexpr unsigned PADDING = 1;
+
+  // Default page size (capped by the GPU's maximum texture size)
+  static constexpr unsigned DEFAULT_PAGE_SIZE = 2048;
+
+  // Where a packed image ended up
+  struct Region {
+    int page = -1;      // -1 = not packed
+    sf::IntRect rect;   // pixel rect on the page
+  };
+
+  explicit TextureAtlas(unsigned pageSize = DEFAULT_PAGE_SIZE);
+
+  // Queues an image file and returns its region ID (-1 if it fails to load).
+  // Adding the same file twice returns the same ID.
+  int add(const std::string &filename);
+
+  // Packs all queued images into pages and uploads them. Images that do not
+  // fit on a page stay unpacked. The source images are released afterwards,
+  // so call clear() before building again. Returns false if no page could be
+  // created.
+  bool build();
+
+  // Drops all images, regions and pages
+  void clear();
+
+  // Region of an image (page -1 if unknown or not packed)
+  const Region &getRegion(int id) const;
+
+  // Page texture behind a region, or nullptr if it was not packed
+  const sf::Texture *getTexture(int id) const;
+
+  size_t getPageCount() const { return pages.size(); }
+  const sf::Texture &getPage(size_t page) const { return pages[page]; }
+
+private:
+  struct Entry {
+    std::string filename;
+    sf::Image image; // released once packed
+    Region region;
+  };
+
+  // Copies an image to dest on a page and extrudes its edges into the padding
+  static void blit(sf::Image &page, const sf::Image &image, sf::Vector2u dest);
+
+  unsigned pageSize;
+  std::vector<Entry> entries;
+  std::vector<sf::Texture> pages;
+  static const Region noRegion;
+};
@@ -14,5 +14,9 @@ public:
 
   virtual void handleInput(sf::Event &event) = 0;
   virtual void update(sf::Time dt) = 0;
-  virtual void render(sf::RenderWindow &window) = 0;
+  virtual void render(sf::RenderTarget &window) = 0;
+
+  // True if the state covers the whole screen, so the states below it are
+  // not rendered at all (e.g. the pause menu over a snapshot of the level)
+  virtual bool isOpaque() const { return false; }
 };
\ No newline at end of file
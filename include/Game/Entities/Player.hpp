@@ -1,19 +1,53 @@
 #pragma once
+#include <Engine/Graphics/DebugDraw.hpp>
+#include <Engine/Graphics/SpriteBatch.hpp>
+#include <Engine/Graphics/TextureAtlas.hpp>
 #include <SFML/Graphics.hpp>
+#include <array>
 
 class Player {
 public:
+  // Keys of one player, two alternatives per action (Key::Unknown = none)
+  struct Controls {
+    using Keys = std::array<sf::Keyboard::Key, 2>;
+    Keys left, right, up, down, jump, dash;
+  };
+
+  // WASD or arrows, Space, Left Shift
+  static const Controls DefaultControls;
+
+  // Keyboard layouts of split-screen players 1 to 4
+  static const std::array<Controls, 4> SplitControls;
+
   Player();
 
+  void setControls(const Controls &newControls) { controls = newControls; }
+
   void update(float dt, const class Map &map);
 
-  void render(sf::RenderWindow &window, bool showHitbox = false);
+  // Queues the sprite
+  void render(SpriteBatch &batch) const;
+
+  // Queues the hitbox
+  void drawDebug(DebugDraw &debug) const;
 
   void reset(sf::Vector2f position);
 
+  // Queues the sprite sheet for packing into atlas
+  void addToAtlas(TextureAtlas &atlas);
+
+  // Draws from the packed atlas page (call after atlas.build()). Loads a
+  // texture of its own only if the sprite sheet was not packed.
+  void useAtlas(const TextureAtlas &atlas);
+
   sf::Vector2f getPosition() const { return shape.getPosition(); }
   sf::Vector2f getVelocity() const { return velocity; }
-  sf::FloatRect getBounds() const { return shape.getGlobalBounds(); }
+
+  // Hitbox for every collision query. Excludes the shape's 1px outline, so
+  // sweeps, wall probes, spikes and finish areas agree on contacts.
+  sf::FloatRect getBounds() const {
+    return sf::FloatRect(shape.getPosition(), shape.getSize());
+  }
 
   // State Getters for HUD
   bool getIsGrounded() const { return isGrounded; }
@@ -23,7 +57,11 @@ public:
   float getDashCooldownTimer() const { return dashCooldownTimer; }
 
 private:
+  // True if either key of an action is held
+  static bool isDown(const Controls::Keys &keys);
+
   sf::RectangleShape shape;
+  Controls controls;
 
   sf::Vector2f velocity;
   bool isGrounded;
@@ -31,6 +69,7 @@ private:
   float moveSpeed;
   float acceleration;
   float friction;
+  float surfaceFriction; // friction multiplier of the tile we stand on
   float gravity;
   float jumpStrength;
 
@@ -65,10 +104,19 @@ private:
   float currentMaxSpeed;
   float speedDecay;
 
-  sf::Texture texture;
-  sf::Sprite sprite;
+  sf::Texture texture;      // only loaded if the sheet was not packed
+  const sf::Texture *sheet; // atlas page or texture
+  sf::IntRect frameRect;
+  sf::Vector2f spritePosition; // bottom center of the hitbox
   bool facingRight;
 
+  // Sprite sheet position in the atlas
+  int atlasId;
+  sf::Vector2i sheetOrigin;
+
+  // Shows frame (column, row) of the 32x32 sprite sheet
+  void setFrame(int column, int row);
+
   // Animation
   enum class AnimState { Idle, WalkStart, RunLoop, Stopping, Jumping, Falling };
   AnimState animState;
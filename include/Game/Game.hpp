@@ -1,9 +1,11 @@
 #pragma once
 
+#include <Engine/Graphics/FontCache.hpp>
 #include <Engine/States/State.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
 #include <memory>
+#include <string>
 #include <vector>
 
 class Game {
@@ -21,16 +23,26 @@ public:
   const sf::RenderWindow &getWindow() const { return mWindow; }
   int getWindowMode() const { return mWindowMode; }
 
+  // Fonts shared by all states
+  FontCache &getFonts() { return mFonts; }
+  static const std::string FontFile;
+
   void cycleWindowMode();
 
+  // Renders the current state stack into texture (resized to the window).
+  // Returns false if the texture could not be created.
+  bool captureFrame(sf::RenderTexture &texture);
+
 private:
   void processEvents();
   void update(sf::Time dt);
   void render();
+  void renderStates(sf::RenderTarget &target);
 
   void applyPendingChanges();
 
   sf::RenderWindow mWindow;
+  FontCache mFonts;
   std::vector<std::unique_ptr<State>> mStates;
 
   static const sf::Time TimePerFrame;
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <Engine/Graphics/DebugDraw.hpp>
+#include <Engine/Graphics/SpriteBatch.hpp>
+#include <Engine/Graphics/TextureAtlas.hpp>
 #include <Engine/States/State.hpp>
 #include <Game/Entities/Player.hpp>
+#include <Game/UI/DebugHud.hpp>
+#include <Game/UI/Minimap.hpp>
 #include <Game/World/Map.hpp>
 #include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
 
 class GameState : public State {
 public:
@@ -11,31 +18,110 @@ public:
 
   void handleInput(sf::Event &event) override;
   void update(sf::Time dt) override;
-  void render(sf::RenderWindow &window) override;
+  void render(sf::RenderTarget &window) override;
 
 private:
   void toggleHitbox();
   void toggleFPS();
   void loadLevel(const std::string &filename);
 
+  // Advances to the next level (or back to the first)
+  void finishLevel();
+
+  // Scales the camera view (1 = normal, powers of two up to the whole level)
+  void setZoom(float zoom);
+
+  // Camera center that follows focus without showing outside the map
+  sf::Vector2f getCameraTarget(const sf::View &camera,
+                               sf::Vector2f focus) const;
+
+  // Eases camera toward focus, snapped to whole pixels
+  void followFocus(sf::View &camera, sf::Vector2f focus, float lerpSpeed,
+                   sf::Time dt) const;
+
+  // Renders cached map chunks where camera is heading
+  void prefetchAhead(const sf::View &camera, sf::Vector2f velocity);
+
+  // Sets the number of split-screen players (1 to MaxPlayers)
+  void setPlayerCount(int count);
+
+  // Splits the window between the cameras (halves for two players, quarters
+  // for three or four) and sizes each view to keep the zoom's pixel scale
+  void updateViewports();
+
+  // Draws background, map, sprites and debug overlay through camera. Every
+  // viewport culls the shared map geometry and fades its hints on its own.
+  void renderWorld(sf::RenderTarget &window, const sf::View &camera,
+                   sf::Vector2f focus, Map::TextHintView &hints);
+
+  // Draws the native-resolution world texture scaled up to the window by
+  // the largest whole factor that fits (centered, letterboxed), or by the
+  // fractional fit if the whole factor would leave too much unused. Returns
+  // the area it covers in window pixels.
+  sf::FloatRect presentWorld(sf::RenderTarget &window);
+
+  // Camera view size at zoom 1
+  static constexpr sf::Vector2f CameraSize{960.f, 540.f};
+
+  // Local split-screen players, including player one
+  static constexpr int MaxPlayers = 4;
+
+  // Size of the world texture in pixel-perfect mode
+  static constexpr sf::Vector2u NativeResolution{960, 540};
+
+  // Smallest share of the fitting size a whole upscale factor must reach
+  // (per axis); below it the world is stretched by the exact fractional fit
+  // instead, e.g. 1.33x at 1280x720 rather than 1x with wide black bars
+  static constexpr float MinIntegerScaleCoverage = 0.9f;
+
+  // Shared texture for the map tilesets and the player sprite sheet
+  TextureAtlas mAtlas;
+
   Player mPlayer;
   Map mMap;
   sf::View mCamera;
+  Map::TextHintView mTextHints; // hints faded for player one
+  float mZoom = 1.f;
+
+  // Split-screen players 2 to 4 (F5), each with its own camera. They
+  // respawn right away instead of playing the death sequence.
+  struct SplitPlayer {
+    Player player;
+    sf::View camera;
+    Map::TextHintView textHints;
+  };
+  std::vector<std::unique_ptr<SplitPlayer>> mSplitPlayers;
+
+  // Entity sprites, drawn in one batch after the map
+  SpriteBatch mSprites;
+
+  // Pixel-perfect mode (F6): the world is rendered at NativeResolution and
+  // upscaled with nearest-neighbor filtering; the UI stays at window size
+  bool mPixelPerfect = false;
+  sf::RenderTexture mWorldTarget;
 
   sf::Texture mBackgroundTexture;
   sf::Sprite mBackgroundSprite;
 
   // Debug features
+  DebugDraw mDebugDraw;
   bool mShowHitbox;
   bool mShowFPS;
 
   // FPS counter
-  sf::Font mFPSFont;
+  const sf::Font &mFPSFont;
   bool mFPSFontLoaded;
   sf::Clock mFPSClock;
   int mFrameCount;
   int mCurrentFPS;
 
+  // Developer HUD (F2)
+  DebugHud mHud;
+
+  // Minimap (M)
+  Minimap mMinimap;
+  bool mShowMinimap = true;
+
   // Smart Reset
   sf::RectangleShape mFadeOverlay;
   float mResetTimer;
@@ -10,10 +10,9 @@ public:
 
   void handleInput(sf::Event &event) override;
   void update(sf::Time dt) override;
-  void render(sf::RenderWindow &window) override;
+  void render(sf::RenderTarget &window) override;
 
 private:
-  sf::Font mFont;
   std::vector<Button> mButtons;
   int mSelectedOptionIndex; // 0 = Start, 1 = Exit
 
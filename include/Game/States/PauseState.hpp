@@ -12,13 +12,20 @@ public:
 
   void handleInput(sf::Event &event) override;
   void update(sf::Time dt) override;
-  void render(sf::RenderWindow &window) override;
+  void render(sf::RenderTarget &window) override;
+
+  // Covers the screen with the snapshot, so the level is not redrawn
+  bool isOpaque() const override { return mHasSnapshot; }
 
 private:
   sf::RectangleShape mBackground;
-  sf::Font mFont;
   sf::Text mPauseText;
 
+  // Dimmed last gameplay frame, captured once on pause
+  sf::RenderTexture mSnapshot;
+  sf::Sprite mSnapshotSprite;
+  bool mHasSnapshot;
+
   std::vector<Button> mButtons;
   int mSelectedOptionIndex;
 
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Engine/GUI/TextWidget.hpp>
+#include <SFML/Graphics.hpp>
+
+class Player;
+
+// Developer HUD (F2): FPS, hitbox toggle, window mode, velocity, dash and
+// movement state. Built from retained text widgets, so a frame in which no
+// value changed costs only the draw calls.
+class DebugHud {
+public:
+  explicit DebugHud(const sf::Font &font);
+
+  // Refreshes the values; only changed lines are rebuilt
+  void update(int fps, bool showHitbox, int windowMode, const Player &player);
+
+  // Draws in the target's current view (screen space)
+  void render(sf::RenderTarget &target) const;
+
+private:
+  // Stacks the lines below each other
+  void updateLayout();
+
+  TextWidget mFPSText;
+  TextWidget mHitboxText;
+  TextWidget mStatsText;
+  TextWidget mDashText;
+  TextWidget mStateText;
+  TextFormatter mFormat;
+};
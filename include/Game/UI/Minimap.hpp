@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+class Map;
+
+// Minimap (M) of the collision layer: walls, platforms, spikes and finish
+// areas, plus a player marker. Tiles are downsampled into a texture once;
+// per frame only the marker moves. The texture covers at most TEXTURE_TILES
+// of the level around the player and is refilled only when the shown area
+// leaves it, so memory stays bounded on very wide maps.
+class Minimap {
+public:
+  // Texture pixels per tile
+  static constexpr int PIXELS_PER_TILE = 2;
+
+  // Texture size in tiles (512x256 px, 512 KB)
+  static constexpr sf::Vector2i TEXTURE_TILES{256, 128};
+
+  // Area shown around the player, in tiles
+  static constexpr sf::Vector2i VIEW_TILES{120, 60};
+
+  Minimap();
+
+  // Fills the texture around focus (call after loading a level)
+  void build(const Map &map, sf::Vector2f focus);
+
+  // Follows the player, refilling the texture only if the shown area leaves
+  // it
+  void update(const Map &map, sf::Vector2f playerPos);
+
+  // Draws at the top-right corner of area (in the target's view
+  // coordinates), e.g. the viewport of the player it follows
+  void render(sf::RenderTarget &target, const sf::FloatRect &area) const;
+
+private:
+  // Downsamples the tiles of mRegion into the texture
+  void fillRegion(const Map &map);
+
+  // Color of a tile on the minimap
+  static sf::Color tileColor(uint8_t collision);
+
+  sf::Texture mTexture;
+  sf::IntRect mRegion; // tiles held by the texture
+  sf::IntRect mView;   // tiles shown, inside mRegion
+  sf::RectangleShape mFrame;
+  sf::RectangleShape mPlayerMarker; // relative to the frame
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Map;
+class ChunkTextureCache;
+
+// Low-detail stand-ins for map chunks, used when zoomed far out.
+// Each chunk is shrunk once into a small tile of a shared page texture (from
+// its mipmapped chunk texture), and all impostors on a page are drawn with a
+// single call, so a frame costs about the same at any zoom level. Pages are
+// limited to BUDGET; least recently visible impostors give up their slots.
+class ChunkImpostorCache {
+public:
+  // Impostor size in pixels per chunk side. Matches the on-screen size of
+  // a chunk at Map::LOD_SCALE, so impostors switch in at 1:1.
+  static constexpr unsigned IMPOSTOR_SIZE = 64;
+
+  // Page texture size (holds (PAGE_SIZE / IMPOSTOR_SIZE)^2 impostors)
+  static constexpr unsigned PAGE_SIZE = 1024;
+
+  // Texture memory for the pages (16 pages, 4096 impostors)
+  static constexpr size_t BUDGET = 64u << 20;
+
+  // Missing impostors built per render() call
+  static constexpr int BUILDS_PER_FRAME = 16;
+
+  // Drops every impostor and page
+  void clear();
+
+  // Builds missing impostors in the chunk range [start, end) (a few per
+  // call), then draws the impostors of that range
+  void render(sf::RenderTarget &target, const Map &map,
+              ChunkTextureCache &chunkCache, sf::Vector2i start,
+              sf::Vector2i end);
+
+private:
+  static constexpr int32_t SLOT_MISSING = -1;
+  static constexpr int32_t SLOT_EMPTY = -2; // chunk has nothing to draw
+
+  struct Page {
+    std::unique_ptr<sf::RenderTexture> target;
+    sf::VertexArray quads{sf::PrimitiveType::Triangles}; // visible only
+  };
+
+  struct Slot {
+    int32_t chunk = -1; // chunk index, -1 = free
+    uint64_t lastUsed = 0;
+  };
+
+  // Number of impostor slots that fit in BUDGET
+  static int32_t getCapacity();
+
+  // Top-left corner of a slot's tile in its page texture
+  static sf::Vector2f getTilePosition(int32_t slot);
+
+  // Renders the impostor of chunk (cx, cy). Returns false if no slot, page
+  // or chunk texture is available; the chunk then stays missing and is
+  // retried.
+  bool build(const Map &map, ChunkTextureCache &chunkCache, int cx, int cy);
+
+  // Finds a free slot or evicts the least recently used impostor that was
+  // not visible in this render() call
+  bool acquireSlot(int32_t &slot);
+
+  // Appends the quad drawing chunk (cx, cy) from its slot to the page
+  void appendQuad(int cx, int cy, int32_t slot);
+
+  std::vector<Page> pages;
+  std::vector<Slot> slots;
+  std::vector<int32_t> slotByChunk; // [chunkY][chunkX]
+  uint64_t useCounter = 0;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+
+// LRU cache of pre-rendered map chunks.
+// All visual layers of a chunk are flattened into one off-screen texture, so
+// a cached chunk is drawn as a single quad no matter how many layers it has.
+// Least recently used chunks are evicted once the memory budget is reached.
+class ChunkTextureCache {
+public:
+  // Default memory budget (64 chunks of 512x512 RGBA)
+  static constexpr size_t DEFAULT_BUDGET = 64u << 20;
+
+  // Chunks rendered ahead of the camera per prefetch() call
+  static constexpr int PREFETCH_PER_CALL = 2;
+
+  // Chunk textures are rendered with alpha blending onto a transparent
+  // clear, so their colors are already multiplied by alpha. Draw them with
+  // this mode, or translucent pixels get their alpha applied twice.
+  inline static const sf::BlendMode BlendPremultiplied{
+      sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha};
+
+  // Sets the texture memory budget in bytes (at least one chunk is kept)
+  void setBudget(size_t bytes);
+  size_t getBudget() const { return budget; }
+
+  // Drops every cached chunk and releases the textures
+  void clear();
+
+  // Texture of chunk (cx, cy), rendered on a miss. Returns nullptr if the
+  // chunk has no visual tiles or its texture could not be created.
+  const sf::Texture *get(const Map &map, int cx, int cy);
+
+  // Draws chunk (cx, cy) shrunk by states.transform, averaging its texels
+  // through mipmaps instead of skipping them. Uses BlendPremultiplied, so the
+  // target keeps premultiplied colors as well. Returns false if the chunk
+  // texture is not available (nothing was drawn).
+  bool drawDownsampled(const Map &map, int cx, int cy,
+                       sf::RenderTarget &target,
+                       const sf::RenderStates &states);
+
+  // Renders up to PREFETCH_PER_CALL missing chunks overlapping area
+  void prefetch(const Map &map, const sf::FloatRect &area);
+
+private:
+  struct Entry {
+    std::unique_ptr<sf::RenderTexture> target;
+    int key = -1; // chunk index, -1 = free
+    uint64_t lastUsed = 0;
+  };
+
+  // Number of chunk textures that fit in the budget
+  size_t getCapacity() const;
+
+  // Finds a free slot or evicts the least recently used chunk
+  bool acquireSlot(size_t &slot);
+
+  std::vector<Entry> entries;
+  std::unordered_map<int, size_t> slotByKey;
+  size_t budget = DEFAULT_BUDGET;
+  uint64_t useCounter = 0;
+};
@@ -1,7 +1,14 @@
 #pragma once
+#include <Engine/Graphics/DebugDraw.hpp>
+#include <Engine/Graphics/TextureAtlas.hpp>
+#include <Game/World/ChunkImpostorCache.hpp>
+#include <Game/World/ChunkTextureCache.hpp>
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Structure for text objects from Tiled object layer
@@ -24,57 +31,291 @@ public:
       0x20000000; // Diagonal flip (Anti-diagonal reflection / swap x, y)
   static constexpr uint32_t TILE_MASK =
       0x1FFFFFFF; // Mask to get actual tile ID
+  static constexpr int FLIP_SHIFT = 29; // Flip flags stored as 3-bit value
+
+  // Flip flags as stored per cell in Layer::flips
+  static constexpr uint8_t CELL_FLIP_H = FLIP_H >> FLIP_SHIFT;
+  static constexpr uint8_t CELL_FLIP_V = FLIP_V >> FLIP_SHIFT;
+  static constexpr uint8_t CELL_FLIP_D = FLIP_D >> FLIP_SHIFT;
+
+  // Per-cell collision flags, merged over all layers at load time
+  enum CollisionFlag : uint8_t {
+    CollisionWall = 1 << 0,
+    CollisionPlatform = 1 << 1,
+    CollisionSpikes = 1 << 2,
+    CollisionFinish = 1 << 3,
+    CollisionStart = 1 << 4
+  };
+
+  // Gameplay properties of a tile, read from the Tiled <tile> type/class
+  // ("start", "finish", "wall", "platform", "spikes") and its <properties>
+  struct TileProperties {
+    uint8_t collision = 0;       // CollisionFlag bits
+    uint8_t hazardInsetX = 4;    // spike hitbox inset on each side (px)
+    uint8_t hazardInsetTop = 10; // spike hitbox inset from the top (px)
+    float friction = 1.f;        // ground friction multiplier
+    float restitution = 0.f;     // bounciness (0 = none)
+  };
+
+  // One frame of a Tiled tile animation
+  struct AnimationFrame {
+    int localId = 0;    // tile shown, from the same tileset
+    int duration = 100; // milliseconds
+  };
 
   struct TilesetInfo {
-    int firstgid;
-    int tilewidth;
-    int tileheight;
-    int tilecount;
-    int columns;
+    int firstgid = 0;
+    int tilewidth = 0;
+    int tileheight = 0;
+    int tilecount = 0;
+    int columns = 0;
     std::string name;
     std::string imageSource;
-    sf::Texture texture;
+    sf::Vector2u imageSize;
+    sf::Texture texture; // only loaded if the image was not packed
+    bool debugOnly = false; // drawn only when hitboxes are shown
+    int atlasId = -1;       // image ID in the texture atlas
+    const sf::Texture *atlasTexture = nullptr; // atlas page, if packed
+    sf::Vector2i atlasOrigin;                  // image position on the page
+    std::vector<TileProperties> tileProperties; // by local tile ID
+    std::vector<uint8_t> opaqueTiles;           // by local tile ID
+    std::vector<std::vector<AnimationFrame>> animations; // by local tile ID
   };
 
-  enum TileType {
-    Start = 0,    // Heart
-    Finish = 1,   // Star
-    Wall = 2,     // Red Block (Solid)
-    Platform = 3, // Platform (One-way)
-    Spikes = 4    // Hazard
+  // Static collider made of merged wall or platform tiles.
+  // Tile coordinates are inclusive.
+  struct Collider {
+    int left;
+    int top;
+    int right;
+    int bottom;
+    uint8_t flags;
+
+    sf::FloatRect getBounds() const {
+      return sf::FloatRect({left * TILE_SIZE, top * TILE_SIZE},
+                           {(right - left + 1) * TILE_SIZE,
+                            (bottom - top + 1) * TILE_SIZE});
+    }
+    bool overlaps(int l, int t, int r, int b) const {
+      return left <= r && right >= l && top <= b && bottom >= t;
+    }
+  };
+
+  // Size of a collider index bucket, in tiles per side
+  static constexpr int COLLIDER_BUCKET_TILES = 8;
+
+  // Size of a render chunk, in tiles per side
+  static constexpr int CHUNK_TILES = 16;
+
+  // Zoom (world pixels per screen pixel) from which chunks are drawn from
+  // low-detail impostors (see ChunkImpostorCache)
+  static constexpr float LOD_SCALE = 8.f;
+
+  // Result of a swept AABB query
+  struct SweepHit {
+    bool hit = false;
+    float time = 1.f;        // fraction of the move done before contact
+    sf::Vector2f normal;     // contact normal, pointing away from collider
+    sf::FloatRect collider;  // bounds of the collider that was hit
+    uint8_t flags = 0;       // collision flags of that collider
+  };
+
+  // Sweep tolerances (pixels)
+  static constexpr float SWEEP_SKIN = 0.01f;          // touching, not inside
+  static constexpr float PLATFORM_TOLERANCE = 4.f;    // land if this far in
+  static constexpr float PLATFORM_MIN_OVERLAP = 4.f;  // horizontal support
+
+  // Ray for batched raycasts (direction does not need to be normalized)
+  struct Ray {
+    sf::Vector2f origin;
+    sf::Vector2f direction;
+    float maxDistance = 0.f;
+  };
+
+  // Result of a raycast
+  struct RayHit {
+    bool hit = false;
+    sf::Vector2i cell{-1, -1}; // tile that stopped the ray
+    sf::Vector2f point;        // where the ray entered that tile
+    float distance = 0.f;      // from the ray origin, in pixels
   };
 
   Map();
 
+  // Font for the text hints (must outlive the map; set before loading)
+  void setFont(const sf::Font &hintFont) { font = &hintFont; }
+
   // Loads map from a TMX file (Tiled format)
   bool loadFromFile(const std::string &filename);
 
   // Getters for map dimensions (in pixels)
-  float getWidth() const {
-    if (layers.empty() || layers[0].grid.empty())
-      return 0.f;
-    return layers[0].grid[0].size() * TILE_SIZE;
+  float getWidth() const { return widthInTiles * TILE_SIZE; }
+  float getHeight() const { return heightInTiles * TILE_SIZE; }
+
+  // Map dimensions in tiles
+  int getWidthInTiles() const { return widthInTiles; }
+  int getHeightInTiles() const { return heightInTiles; }
+
+  // Returns the collision flags of a tile cell (0 outside the map)
+  uint8_t getCollisionAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= widthInTiles || y >= heightInTiles)
+      return 0;
+    return collisionGrid[y * widthInTiles + x];
   }
-  float getHeight() const {
-    return layers.empty() ? 0.f : layers[0].grid.size() * TILE_SIZE;
+
+  // True if any cell in the inclusive tile span carries the given flag
+  // (CollisionWall, CollisionPlatform or CollisionSpikes). Uses per-row
+  // 64-bit bitboards, so a span costs a few masked word tests per row.
+  bool anyInSpan(uint8_t flag, int left, int top, int right, int bottom) const;
+
+  // Clamped tile range covered by bounds; false if it lies outside the map
+  bool getTileRange(const sf::FloatRect &bounds, int &left, int &top,
+                    int &right, int &bottom) const;
+
+  // Properties of a tile ID (defaults for unknown IDs)
+  const TileProperties &getTileProperties(int globalId) const {
+    if (globalId <= 0 ||
+        globalId >= static_cast<int>(tilePropertiesById.size()))
+      return defaultTileProperties;
+    return tilePropertiesById[globalId];
+  }
+
+  // Properties of the tile that defines a cell's collision
+  const TileProperties &getTilePropertiesAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= widthInTiles || y >= heightInTiles)
+      return defaultTileProperties;
+    return getTileProperties(collisionTiles[y * widthInTiles + x]);
   }
 
   // Returns the player spawn position extracted from the map file
   sf::Vector2f getStartPosition() const { return startPosition; }
 
-  // Renders only the visible portion of the map (view culling)
-  void render(sf::RenderWindow &window, sf::Vector2f playerPos = {0, 0},
-              bool showHitboxes = false);
+  // Text hints drawn by one viewport last frame. Hints fade with the
+  // distance to that viewport's player, so every camera keeps its own.
+  struct TextHintView {
+    std::vector<uint32_t> visible; // hint indices (sorted)
+    std::vector<uint8_t> alphas;   // fade level of each visible hint
+    sf::VertexArray batch{sf::PrimitiveType::Triangles};
+    uint32_t generation = 0; // textHintGeneration the batch was built from
+  };
+
+  // Renders only the visible portion of the map (view culling). Far zoomed
+  // out, chunks are drawn from impostors and debug tiles are left out
+  // (unless tiles spill across chunks, see hasSpillingTiles).
+  void render(sf::RenderTarget &window, TextHintView &hints,
+              sf::Vector2f playerPos = {0, 0}, bool showHitboxes = false);
+
+  // Queues merged colliders and spike hitboxes overlapping area
+  void drawDebug(DebugDraw &debug, const sf::FloatRect &area) const;
+
+  // Number of render chunks along each axis
+  int getChunksX() const { return chunksX; }
+  int getChunksY() const { return chunksY; }
+
+  // True if chunk (cx, cy) has tiles outside of debug-only tilesets
+  bool hasVisualTiles(int cx, int cy) const;
 
-  // Checks for collisions between an entity's bounding box and the map walls.
-  std::vector<sf::FloatRect> checkCollision(const sf::FloatRect &bounds) const;
+  // True if chunk (cx, cy) shows animated tiles (it is never cached)
+  bool hasAnimatedTiles(int cx, int cy) const;
+
+  // Advances the tile animations and rewrites the texture coordinates of
+  // the animated tiles whose frame changed
+  void updateAnimations(sf::Time dt);
+
+  // Draws chunk (cx, cy), all layers back to front or only one layer.
+  // drawVisual and drawDebug select the regular and the debug-only tilesets.
+  void drawChunk(sf::RenderTarget &target, int cx, int cy,
+                 const sf::RenderStates &states, bool drawVisual,
+                 bool drawDebug, int layer = -1) const;
+
+  // True if some tiles are larger than a cell and reach into neighboring
+  // chunks. Such maps are drawn layer by layer at every zoom level and use
+  // neither cached chunks nor impostors.
+  bool hasSpillingTiles() const { return tileSpill > 0; }
+
+  // Queues the tileset images for packing into atlas
+  void addToAtlas(TextureAtlas &atlas);
+
+  // Draws tiles from the packed atlas pages (call after atlas.build()).
+  // Only tilesets that were not packed load a texture of their own.
+  void useAtlas(const TextureAtlas &atlas);
+
+  // Draw chunks from pre-rendered textures (see ChunkTextureCache)
+  void setChunkCaching(bool enabled);
+  bool isChunkCaching() const { return chunkCaching; }
+  void setChunkCacheBudget(size_t bytes) { chunkCache.setBudget(bytes); }
+
+  // Renders cached chunks overlapping area ahead of time (no-op when
+  // chunk caching is off)
+  void prefetchChunks(const sf::FloatRect &area);
+
+  // Returns true if any wall tile intersects bounds
+  bool hasCollision(const sf::FloatRect &bounds) const;
 
   // Checks if the player bounds intersect with the finish tile
   bool checkFinish(const sf::FloatRect &bounds) const;
 
-  // Returns platform tiles that intersect with bounds (one-way platforms)
-  std::vector<sf::FloatRect>
-  checkPlatformCollision(const sf::FloatRect &bounds) const;
+  // Sweeps bounds by delta against the colliders matching mask and returns
+  // the earliest contact. Colliders already overlapping bounds are ignored so
+  // an entity can always move out. One-way platforms only stop downward
+  // movement that starts above them.
+  SweepHit sweep(const sf::FloatRect &bounds, sf::Vector2f delta,
+                 uint8_t mask) const;
+
+  // Narrow phase of sweep(): tests a single collider and keeps the earlier
+  // contact in best (ties prefer vertical contacts, so floors win at seams)
+  static void sweepCollider(const sf::FloatRect &bounds, sf::Vector2f delta,
+                            const Collider &collider, SweepHit &best);
+
+  // Area covered by bounds while moving by delta
+  static sf::FloatRect getSweptBounds(const sf::FloatRect &bounds,
+                                      sf::Vector2f delta);
+
+  // Casts a ray through the collision layer (grid DDA) and stops at the first
+  // cell matching mask. A ray starting inside such a cell hits at distance 0.
+  RayHit raycast(sf::Vector2f origin, sf::Vector2f direction,
+                 float maxDistance, uint8_t mask = CollisionWall) const;
+
+  // Casts many rays at once; hits[i] receives the result of rays[i]
+  void raycast(std::span<const Ray> rays, std::span<RayHit> hits,
+               uint8_t mask = CollisionWall) const;
+
+  // True if no cell matching mask lies on the segment between from and to
+  bool hasLineOfSight(sf::Vector2f from, sf::Vector2f to,
+                      uint8_t mask = CollisionWall) const;
+
+  // Calls visit(collider) once for every merged collider matching mask that
+  // overlaps the inclusive tile range (as returned by getTileRange)
+  template <typename Visitor>
+  void forEachCollider(int left, int top, int right, int bottom, uint8_t mask,
+                       Visitor &&visit) const {
+    if (colliderBucketStart.empty())
+      return;
+
+    const int B = COLLIDER_BUCKET_TILES;
+    int bucketLeft = left / B;
+    int bucketTop = top / B;
+    int bucketRight = std::min(right / B, colliderBucketsX - 1);
+    int bucketBottom = std::min(bottom / B, colliderBucketsY - 1);
+
+    for (int by = bucketTop; by <= bucketBottom; ++by) {
+      for (int bx = bucketLeft; bx <= bucketRight; ++bx) {
+        int bucket = by * colliderBucketsX + bx;
+        for (uint32_t i = colliderBucketStart[bucket];
+             i < colliderBucketStart[bucket + 1]; ++i) {
+          const Collider &c = colliders[colliderBucketItems[i]];
+          if (!(c.flags & mask) || !c.overlaps(left, top, right, bottom))
+            continue;
+          // Report a collider only from the first bucket it shares with the
+          // query, so large colliders are not visited twice
+          if (std::max(c.left / B, bucketLeft) != bx ||
+              std::max(c.top / B, bucketTop) != by)
+            continue;
+          visit(c);
+        }
+      }
+    }
+  }
 
   // Checks if the player bounds intersect with a spike tile
   bool checkSpikeCollision(const sf::FloatRect &bounds) const;
@@ -83,26 +324,172 @@ private:
   // Parse TMX XML content
   bool parseTMX(const std::string &content, const std::string &basePath);
 
-  // Parse a single layer's CSV data
-  std::vector<std::vector<uint32_t>> parseLayerData(const std::string &csvData,
-                                                    int width, int height);
+  struct Layer;
+
+  // Parse a single layer's CSV data into a flat row-major tile buffer
+  void parseLayerData(const std::string &csvData, Layer &layer);
+
+  // Load a tileset image to find its size and fully opaque tiles. The GPU
+  // texture comes from the atlas (see useAtlas).
+  bool loadTilesetImage(TilesetInfo &ts);
+
+  // Parse tileset-level and per-tile <properties> of a tileset definition
+  void parseTileProperties(const std::string &tilesetContent,
+                           TilesetInfo &ts);
+
+  // Gives an untyped ts_main / MainTileset the collision of its columns, as
+  // maps made before tile types expect (warns, and marks it debug-only)
+  void applyLegacyTileTypes(TilesetInfo &ts);
+
+  // Build the tile ID -> tileset / texture rect lookup tables
+  void buildTileLookup();
+
+  // Bake the merged collision layer, spawn point and finish triggers
+  void buildCollisionLayer();
+
+  // Greedily merge wall and platform cells into colliders and index them
+  void buildColliders();
+
+  // Pack walls, platforms and hazards into per-row bitsets
+  void buildBitboards();
+
+  // Bake every layer into static per-chunk vertex arrays, leaving out tiles
+  // hidden under opaque tiles of higher layers
+  void buildChunks();
+
+  // Writes the two triangles of tile (x, y), with the Tiled flips baked into
+  // the texture coordinates, to quad[0..5]
+  static void writeTileQuad(sf::Vertex *quad, int x, int y,
+                            const sf::IntRect &textureRect, uint8_t flips);
+
+  // Writes only the texture coordinates of a tile quad (see writeTileQuad)
+  static void writeTileTexCoords(sf::Vertex *quad,
+                                 const sf::IntRect &textureRect,
+                                 uint8_t flips);
 
   // Parse object groups (like text hints)
   void parseObjectGroup(const std::string &content);
 
-  // Helpers to prepare rendering data
-  void prepareTextObjects();
+  // Bake text hints into glyph quads and bucket them for culling
+  void buildTextHints();
 
+  // Draws the hints near the player with one draw call
+  void renderTextHints(sf::RenderTarget &target, TextHintView &hints,
+                       const sf::FloatRect &view, sf::Vector2f playerPos);
+
+  // Tile layer stored as one contiguous row-major buffer.
+  // Tile IDs are 16-bit (0 = empty), flip flags are kept in a parallel array
+  // so the hot loops only touch the IDs.
   struct Layer {
     std::string name;
-    std::vector<std::vector<uint32_t>> grid;
+    int width = 0;
+    int height = 0;
+    std::vector<uint16_t> tiles;
+    std::vector<uint8_t> flips;
+
+    uint16_t tileAt(int x, int y) const { return tiles[y * width + x]; }
+    uint8_t flipsAt(int x, int y) const { return flips[y * width + x]; }
   };
   // Map data
   std::vector<Layer> layers;
+  int widthInTiles = 0;
+  int heightInTiles = 0;
+  std::vector<uint8_t> collisionGrid;
+  std::vector<uint16_t> collisionTiles; // tile ID behind each collision cell
+
+  // Per-row bitsets (bit x of row y = cell x,y), bitboardWords words per row
+  std::vector<uint64_t> solidBits;
+  std::vector<uint64_t> platformBits;
+  std::vector<uint64_t> hazardBits;
+  int bitboardWords = 0;
+
+  // Static geometry of one chunk: triangle lists in draw order (layers back to
+  // front). Consecutive tiles sharing a texture go into the same batch, so
+  // with an atlas a chunk is usually a single draw call. If tiles spill over
+  // their cell, batches also end at layer boundaries.
+  struct ChunkBatch {
+    const sf::Texture *texture = nullptr;
+    bool debugOnly = false;
+    int layer = 0; // first layer in the batch
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+  };
+  struct Chunk {
+    std::vector<ChunkBatch> batches;
+    bool animated = false; // has tiles in animatedTiles
+  };
+
+  // Render chunks, indexed [chunkY][chunkX]
+  std::vector<Chunk> chunks;
+  int chunksX = 0;
+  int chunksY = 0;
+  size_t occludedTiles = 0; // tiles left out of the chunks
+  int tileSpill = 0;        // pixels the largest tiles reach past their cell
+
+  // Tile animations with their frames resolved to texture rects. All frames
+  // come from one tileset, so they share the tile size.
+  struct TileAnimation {
+    std::vector<sf::IntRect> frameRects;
+    std::vector<int> frameEnds; // end time of each frame in the loop (ms)
+    int frame = 0;              // frame currently in the chunk vertices
+  };
+  std::vector<TileAnimation> animations;
+  int64_t animationTime = 0; // microseconds
+
+  // Animated tile instance: where its quad sits in the chunk geometry
+  struct AnimatedTile {
+    uint32_t chunk;
+    uint32_t batch;
+    uint32_t firstVertex;
+    uint8_t flips;
+  };
+
+  // Animated tiles grouped by animation (CSR layout), so a frame change
+  // only touches the tiles of that animation
+  std::vector<uint32_t> animatedTileStart;
+  std::vector<AnimatedTile> animatedTiles;
+
+  // Flattened chunk textures
+  ChunkTextureCache chunkCache;
+  bool chunkCaching = false;
+
+  // Shrunk chunk textures for zoomed-out views
+  ChunkImpostorCache chunkImpostors;
+
+  // Merged static colliders, bucketed on a uniform grid (CSR layout)
+  std::vector<Collider> colliders;
+  std::vector<uint32_t> colliderBucketStart;
+  std::vector<uint32_t> colliderBucketItems;
+  int colliderBucketsX = 0;
+  int colliderBucketsY = 0;
   std::vector<MapText> textObjects;
 
-  // Cached sf::Text objects for rendering (avoid allocation in render loop)
-  std::vector<sf::Text> cachedTexts;
+  // Text hint rendering
+  static constexpr unsigned HINT_CHARACTER_SIZE = 12;
+  static constexpr float HINT_OUTLINE = 1.f;
+  static constexpr float HINT_FADE_START = 75.f; // fully visible within (px)
+  static constexpr float HINT_FADE_END = 150.f;  // invisible outside (px)
+  static constexpr float HINT_BUCKET_SIZE = 256.f;
+
+  // Glyph quads of one hint in textHintVertices (outline quads first)
+  struct TextHint {
+    sf::FloatRect bounds;
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+  };
+  std::vector<TextHint> textHints;
+  std::vector<sf::Vertex> textHintVertices;
+
+  // Hints bucketed on a uniform grid (CSR layout)
+  std::vector<uint32_t> textHintBucketStart;
+  std::vector<uint32_t> textHintBucketItems;
+  int textHintBucketsX = 0;
+  int textHintBucketsY = 0;
+
+  // Bumped whenever the hints are rebuilt, so stale views start over
+  uint32_t textHintGeneration = 0;
+
+  // Hints and fade levels found this frame (scratch, sorted by index)
+  std::vector<std::pair<uint32_t, uint8_t>> frameTextHints;
 
   sf::Vector2f startPosition{100.f, 100.f};
   std::vector<sf::FloatRect> finishAreas;
@@ -113,10 +500,20 @@ private:
   // Data storages
   std::vector<TilesetInfo> tilesets;
 
-  // Cached objects
-  sf::Font font;
-  bool fontLoaded = false;
+  // Dense lookup tables indexed by tile ID (built once after tilesets load)
+  std::vector<int16_t> tilesetIndexById; // -1 = no tileset
+  std::vector<sf::IntRect> textureRectById;
+  std::vector<TileProperties> tilePropertiesById;
+  std::vector<uint8_t> tileOccludesById; // opaque and covers the whole cell
+  std::vector<int16_t> animationById;    // -1 = static tile
+  static const TileProperties defaultTileProperties;
+
+  // Shared font for the text hints (not owned)
+  const sf::Font *font = nullptr;
 
   // Helpers
   const TilesetInfo *getTilesetForId(int globalId) const;
+
+  // Hazard area of a spike tile (smaller than the tile itself)
+  sf::FloatRect getSpikeBounds(int x, int y) const;
 };
@@ -0,0 +1,40 @@
+#pragma once
+#include <Game/World/Map.hpp>
+#include <array>
+#include <cstdint>
+
+// Snapshot of the map colliders around an entity.
+// Captured once per tick so that the move-and-slide sweeps of that tick
+// iterate a handful of merged colliders instead of rescanning the map.
+// Sweeps reaching outside the captured tile range are forwarded to the map,
+// so results stay correct if the entity moves further than predicted.
+class TileNeighborhood {
+public:
+  // Maximum number of colliders kept in the snapshot
+  static constexpr int MAX_COLLIDERS = 32;
+
+  // Copies every wall and platform collider touching area
+  void capture(const Map &map, const sf::FloatRect &area);
+
+  // Boolean wall probe, answered by the map's row bitboards
+  bool hasCollision(const sf::FloatRect &bounds) const;
+
+  // Swept AABB against the snapshot (see Map::sweep)
+  Map::SweepHit sweep(const sf::FloatRect &bounds, sf::Vector2f delta,
+                      uint8_t mask) const;
+
+private:
+  // True if the tile range lies inside the captured range
+  bool covers(int l, int t, int r, int b) const {
+    return valid && l >= left && t >= top && r <= right && b <= bottom;
+  }
+
+  const Map *map = nullptr;
+  bool valid = false;
+  int left = 0;
+  int top = 0;
+  int right = -1;
+  int bottom = -1;
+  std::array<Map::Collider, MAX_COLLIDERS> colliders;
+  int count = 0;
+};
@@ -35,4 +35,4 @@ bool Button::contains(sf::Vector2f point) const {
   return mText.getGlobalBounds().contains(point);
 }
 
-void Button::render(sf::RenderWindow &window) { window.draw(mText); }
+void Button::render(sf::RenderTarget &window) { window.draw(mText); }
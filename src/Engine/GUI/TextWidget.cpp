@@ -0,0 +1,71 @@
+#include <Engine/GUI/TextWidget.hpp>
+#include <Engine/Graphics/TextGeometry.hpp>
+#include <algorithm>
+#include <cstring>
+
+TextFormatter &TextFormatter::operator<<(std::string_view str) {
+  size_t count = std::min(str.size(), CAPACITY - mSize);
+  std::memcpy(mData + mSize, str.data(), count);
+  mSize += count;
+  return *this;
+}
+
+TextFormatter &TextFormatter::operator<<(int value) {
+  auto result = std::to_chars(mData + mSize, mData + CAPACITY, value);
+  if (result.ec == std::errc())
+    mSize = result.ptr - mData;
+  return *this;
+}
+
+TextFormatter &TextFormatter::fixed(float value, int decimals) {
+  auto result = std::to_chars(mData + mSize, mData + CAPACITY, value,
+                              std::chars_format::fixed, decimals);
+  if (result.ec == std::errc())
+    mSize = result.ptr - mData;
+  return *this;
+}
+
+TextWidget::TextWidget(const sf::Font &font, unsigned characterSize,
+                       float outlineThickness)
+    : mFont(font), mCharacterSize(characterSize),
+      mOutlineThickness(outlineThickness) {
+  // Room for a typical label, so updates do not allocate
+  mText.reserve(TextFormatter::CAPACITY);
+  mVertices.reserve(TextFormatter::CAPACITY * 12);
+}
+
+bool TextWidget::setText(std::string_view text) {
+  if (text == mText)
+    return false;
+  mText.assign(text);
+  rebuild();
+  return true;
+}
+
+void TextWidget::setColor(sf::Color color) {
+  if (color == mColor)
+    return;
+  mColor = color;
+  for (size_t i = mOutlineVertices; i < mVertices.size(); ++i)
+    mVertices[i].color = color;
+}
+
+void TextWidget::rebuild() {
+  mVertices.clear();
+  mBounds = appendText(mVertices, mFont, mText, mCharacterSize, {0.f, 0.f},
+                       mColor, mOutlineThickness);
+
+  // With an outline, the first half of the quads is the outline
+  mOutlineVertices = mOutlineThickness > 0.f ? mVertices.size() / 2 : 0;
+}
+
+void TextWidget::render(sf::RenderTarget &target) const {
+  if (mVertices.empty())
+    return;
+
+  sf::RenderStates states;
+  states.transform.translate(mPosition);
+  states.texture = &mFont.getTexture(mCharacterSize);
+  target.draw(mVertices.data(), mVertices.size(),
+              sf::PrimitiveType::Triangles, states);
+}
@@ -0,0 +1,88 @@
+#include <Engine/Graphics/DebugDraw.hpp>
+#include <Engine/Graphics/TextGeometry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+// Inside the 2x2 white square at the top-left of every font page
+const sf::Vector2f WHITE_TEXEL{1.f, 1.f};
+} // namespace
+
+void DebugDraw::setFont(const sf::Font &labelFont, unsigned size) {
+  font = &labelFont;
+  characterSize = size;
+}
+
+void DebugDraw::quad(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c,
+                     sf::Vector2f d, sf::Color color) {
+  // a-b-c-d in order around the quad
+  vertices.push_back({a, color, WHITE_TEXEL});
+  vertices.push_back({b, color, WHITE_TEXEL});
+  vertices.push_back({d, color, WHITE_TEXEL});
+  vertices.push_back({d, color, WHITE_TEXEL});
+  vertices.push_back({b, color, WHITE_TEXEL});
+  vertices.push_back({c, color, WHITE_TEXEL});
+}
+
+void DebugDraw::rect(const sf::FloatRect &bounds, sf::Color fill,
+                     sf::Color outline, float outlineThickness) {
+  sf::Vector2f p0 = bounds.position;
+  sf::Vector2f p1 = bounds.position + bounds.size;
+  if (fill.a > 0)
+    quad(p0, {p1.x, p0.y}, p1, {p0.x, p1.y}, fill);
+
+  if (outline.a == 0 || outlineThickness <= 0.f)
+    return;
+  float t = std::min(outlineThickness,
+                     std::min(bounds.size.x, bounds.size.y) / 2.f);
+  quad(p0, {p1.x, p0.y}, {p1.x, p0.y + t}, {p0.x, p0.y + t}, outline);
+  quad({p0.x, p1.y - t}, {p1.x, p1.y - t}, p1, {p0.x, p1.y}, outline);
+  quad({p0.x, p0.y + t}, {p0.x + t, p0.y + t}, {p0.x + t, p1.y - t},
+       {p0.x, p1.y - t}, outline);
+  quad({p1.x - t, p0.y + t}, {p1.x, p0.y + t}, {p1.x, p1.y - t},
+       {p1.x - t, p1.y - t}, outline);
+}
+
+void DebugDraw::line(sf::Vector2f from, sf::Vector2f to, sf::Color color,
+                     float thickness) {
+  sf::Vector2f d = to - from;
+  float length = std::sqrt(d.x * d.x + d.y * d.y);
+  if (length <= 0.f)
+    return;
+  sf::Vector2f n(-d.y / length * thickness / 2.f,
+                 d.x / length * thickness / 2.f);
+  quad(from + n, to + n, to - n, from - n, color);
+}
+
+void DebugDraw::circle(sf::Vector2f center, float radius, sf::Color color,
+                       int segments) {
+  const float step = 2.f * std::numbers::pi_v<float> / segments;
+  sf::Vector2f prev = center + sf::Vector2f(radius, 0.f);
+  for (int i = 1; i <= segments; ++i) {
+    sf::Vector2f next = center + sf::Vector2f(radius * std::cos(i * step),
+                                              radius * std::sin(i * step));
+    vertices.push_back({center, color, WHITE_TEXEL});
+    vertices.push_back({prev, color, WHITE_TEXEL});
+    vertices.push_back({next, color, WHITE_TEXEL});
+    prev = next;
+  }
+}
+
+void DebugDraw::text(sf::Vector2f position, std::string_view str,
+                     sf::Color color) {
+  if (font)
+    appendText(vertices, *font, str, characterSize, position, color);
+}
+
+void DebugDraw::flush(sf::RenderTarget &target,
+                      const sf::RenderStates &states) {
+  if (vertices.empty())
+    return;
+
+  sf::RenderStates batchStates = states;
+  batchStates.texture = font ? &font->getTexture(characterSize) : nullptr;
+  target.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles,
+              batchStates);
+  vertices.clear();
+}
@@ -0,0 +1,47 @@
+#include <Engine/Graphics/FontCache.hpp>
+#include <iostream>
+
+const std::u32string FontCache::DEFAULT_GLYPHS = [] {
+  std::u32string glyphs;
+  for (char32_t c = U' '; c <= U'~'; ++c)
+    glyphs += c;
+  return glyphs;
+}();
+
+FontCache::Entry &FontCache::load(const std::string &filename) {
+  auto it = fonts.find(filename);
+  if (it != fonts.end())
+    return it->second;
+
+  Entry entry;
+  entry.font = std::make_unique<sf::Font>();
+  entry.loaded = entry.font->openFromFile(filename);
+  if (!entry.loaded)
+    std::cerr << "Failed to load font: " << filename << std::endl;
+  return fonts.emplace(filename, std::move(entry)).first->second;
+}
+
+const sf::Font &FontCache::get(const std::string &filename) {
+  return *load(filename).font;
+}
+
+bool FontCache::isLoaded(const std::string &filename) {
+  return load(filename).loaded;
+}
+
+void FontCache::prewarm(const std::string &filename,
+                        std::initializer_list<GlyphSize> sizes,
+                        const std::u32string &glyphs) {
+  Entry &entry = load(filename);
+  if (!entry.loaded)
+    return;
+
+  for (const GlyphSize &size : sizes) {
+    for (char32_t c : glyphs) {
+      (void)entry.font->getGlyph(c, size.characterSize, false);
+      if (size.outlineThickness > 0.f)
+        (void)entry.font->getGlyph(c, size.characterSize, false,
+                                   size.outlineThickness);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+#include <Engine/Graphics/SpriteBatch.hpp>
+#include <algorithm>
+#include <functional>
+
+void SpriteBatch::draw(const sf::Texture &texture,
+                       const sf::IntRect &textureRect,
+                       const sf::Transform &transform, sf::Color color,
+                       int layer, bool flipX, bool flipY) {
+  sf::Vector2f size(textureRect.size);
+  float left = static_cast<float>(textureRect.position.x);
+  float top = static_cast<float>(textureRect.position.y);
+  float right = left + size.x;
+  float bottom = top + size.y;
+  if (flipX)
+    std::swap(left, right);
+  if (flipY)
+    std::swap(top, bottom);
+
+  sf::Vector2f p0 = transform.transformPoint({0.f, 0.f});
+  sf::Vector2f p1 = transform.transformPoint({size.x, 0.f});
+  sf::Vector2f p2 = transform.transformPoint({0.f, size.y});
+  sf::Vector2f p3 = transform.transformPoint(size);
+
+  sprites.push_back({&texture, layer, static_cast<uint32_t>(queued.size())});
+  queued.push_back({p0, color, {left, top}});
+  queued.push_back({p1, color, {right, top}});
+  queued.push_back({p2, color, {left, bottom}});
+  queued.push_back({p2, color, {left, bottom}});
+  queued.push_back({p1, color, {right, top}});
+  queued.push_back({p3, color, {right, bottom}});
+}
+
+void SpriteBatch::flush(sf::RenderTarget &target,
+                        const sf::RenderStates &states) {
+  if (sprites.empty())
+    return;
+
+  std::stable_sort(sprites.begin(), sprites.end(),
+                   [](const Sprite &a, const Sprite &b) {
+                     if (a.layer != b.layer)
+                       return a.layer < b.layer;
+                     return std::less<const sf::Texture *>()(a.texture,
+                                                             b.texture);
+                   });
+
+  // Gather the vertices in draw order, then draw one range per texture run
+  // (a run may span several layers)
+  sorted.clear();
+  for (const Sprite &sprite : sprites)
+    sorted.insert(sorted.end(), queued.begin() + sprite.firstVertex,
+                  queued.begin() + sprite.firstVertex + 6);
+
+  sf::RenderStates batchStates = states;
+  size_t first = 0;
+  while (first < sprites.size()) {
+    size_t last = first + 1;
+    while (last < sprites.size() &&
+           sprites[last].texture == sprites[first].texture)
+      ++last;
+
+    batchStates.texture = sprites[first].texture;
+    target.draw(&sorted[first * 6], (last - first) * 6,
+                sf::PrimitiveType::Triangles, batchStates);
+    first = last;
+  }
+  clear();
+}
+
+void SpriteBatch::clear() {
+  sprites.clear();
+  queued.clear();
+}
@@ -0,0 +1,85 @@
+#include <Engine/Graphics/TextGeometry.hpp>
+#include <algorithm>
+
+void appendGlyphQuad(std::vector<sf::Vertex> &vertices, sf::Vector2f pos,
+                     sf::Color color, const sf::Glyph &glyph) {
+  // Same 1px texture padding as sf::Text
+  const float padding = 1.f;
+  float left = glyph.bounds.position.x - padding;
+  float top = glyph.bounds.position.y - padding;
+  float right = glyph.bounds.position.x + glyph.bounds.size.x + padding;
+  float bottom = glyph.bounds.position.y + glyph.bounds.size.y + padding;
+
+  float u1 = static_cast<float>(glyph.textureRect.position.x) - padding;
+  float v1 = static_cast<float>(glyph.textureRect.position.y) - padding;
+  float u2 = static_cast<float>(glyph.textureRect.position.x +
+                                glyph.textureRect.size.x) +
+             padding;
+  float v2 = static_cast<float>(glyph.textureRect.position.y +
+                                glyph.textureRect.size.y) +
+             padding;
+
+  vertices.push_back({{pos.x + left, pos.y + top}, color, {u1, v1}});
+  vertices.push_back({{pos.x + right, pos.y + top}, color, {u2, v1}});
+  vertices.push_back({{pos.x + left, pos.y + bottom}, color, {u1, v2}});
+  vertices.push_back({{pos.x + left, pos.y + bottom}, color, {u1, v2}});
+  vertices.push_back({{pos.x + right, pos.y + top}, color, {u2, v1}});
+  vertices.push_back({{pos.x + right, pos.y + bottom}, color, {u2, v2}});
+}
+
+sf::FloatRect appendText(std::vector<sf::Vertex> &vertices,
+                         const sf::Font &font, std::string_view str,
+                         unsigned characterSize, sf::Vector2f position,
+                         sf::Color fillColor, float outlineThickness,
+                         sf::Color outlineColor) {
+  size_t first = vertices.size();
+  float whitespace = font.getGlyph(U' ', characterSize, false).advance;
+  float lineSpacing = font.getLineSpacing(characterSize);
+
+  // Outline pass first (if any), then the fill on top of it
+  for (int pass = outlineThickness > 0.f ? 0 : 1; pass < 2; ++pass) {
+    bool outline = pass == 0;
+    sf::Vector2f pen(0.f, static_cast<float>(characterSize));
+    char32_t prev = 0;
+
+    for (auto it = str.begin(); it != str.end();) {
+      char32_t c = 0;
+      it = sf::Utf8::decode(it, str.end(), c);
+      if (c == U'\r')
+        continue;
+      pen.x += font.getKerning(prev, c, characterSize);
+      prev = c;
+
+      if (c == U' ' || c == U'\t' || c == U'\n') {
+        if (c == U' ')
+          pen.x += whitespace;
+        else if (c == U'\t')
+          pen.x += whitespace * 4.f;
+        else
+          pen = {0.f, pen.y + lineSpacing};
+        continue;
+      }
+
+      if (outline)
+        appendGlyphQuad(
+            vertices, position + pen, outlineColor,
+            font.getGlyph(c, characterSize, false, outlineThickness));
+      else
+        appendGlyphQuad(vertices, position + pen, fillColor,
+                        font.getGlyph(c, characterSize, false));
+      pen.x += font.getGlyph(c, characterSize, false).advance;
+    }
+  }
+
+  if (vertices.size() == first)
+    return sf::FloatRect(position, {0.f, 0.f});
+
+  sf::Vector2f min = vertices[first].position;
+  sf::Vector2f max = min;
+  for (size_t i = first + 1; i < vertices.size(); ++i) {
+    const sf::Vector2f &p = vertices[i].position;
+    min = {std::min(min.x, p.x), std::min(min.y, p.y)};
+    max = {std::max(max.x, p.x), std::max(max.y, p.y)};
+  }
+  return sf::FloatRect(min, max - min);
+}
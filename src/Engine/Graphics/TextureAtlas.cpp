@@ -0,0 +1,147 @@
+#include <Engine/Graphics/TextureAtlas.hpp>
+#include <algorithm>
+#include <iostream>
+
+const TextureAtlas::Region TextureAtlas::noRegion{};
+
+TextureAtlas::TextureAtlas(unsigned pageSize) : pageSize(pageSize) {}
+
+int TextureAtlas::add(const std::string &filename) {
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (entries[i].filename == filename)
+      return static_cast<int>(i);
+  }
+
+  Entry entry;
+  entry.filename = filename;
+  if (!entry.image.loadFromFile(filename)) {
+    std::cerr << "Failed to load atlas image: " << filename << std::endl;
+    return -1;
+  }
+  entries.push_back(std::move(entry));
+  return static_cast<int>(entries.size() - 1);
+}
+
+bool TextureAtlas::build() {
+  pages.clear();
+  unsigned maxSize = std::min(pageSize, sf::Texture::getMaximumSize());
+
+  // Tallest images first keeps the shelves tight
+  std::vector<size_t> order;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    entries[i].region = Region();
+    if (entries[i].image.getSize().x > 0)
+      order.push_back(i);
+  }
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    sf::Vector2u sa = entries[a].image.getSize();
+    sf::Vector2u sb = entries[b].image.getSize();
+    return sa.y != sb.y ? sa.y > sb.y : sa.x > sb.x;
+  });
+
+  // Shelf packing: fill a row left to right, then open a new row below it,
+  // then a new page
+  std::vector<sf::Vector2u> pageSizes;
+  unsigned x = 0, shelfY = 0, shelfHeight = 0;
+  for (size_t i : order) {
+    Entry &entry = entries[i];
+    sf::Vector2u size = entry.image.getSize();
+    unsigned w = size.x + 2 * PADDING;
+    unsigned h = size.y + 2 * PADDING;
+    if (w > maxSize || h > maxSize) {
+      std::cerr << "Image too large for texture atlas: " << entry.filename
+                << std::endl;
+      continue;
+    }
+
+    if (pageSizes.empty() || x + w > maxSize) {
+      shelfY += shelfHeight;
+      x = 0;
+      shelfHeight = 0;
+    }
+    if (pageSizes.empty() || shelfY + h > maxSize) {
+      pageSizes.push_back({0, 0});
+      x = 0;
+      shelfY = 0;
+      shelfHeight = 0;
+    }
+
+    sf::Vector2u &pageUsed = pageSizes.back();
+    entry.region.page = static_cast<int>(pageSizes.size() - 1);
+    entry.region.rect =
+        sf::IntRect({static_cast<int>(x + PADDING),
+                     static_cast<int>(shelfY + PADDING)},
+                    sf::Vector2i(size));
+    x += w;
+    shelfHeight = std::max(shelfHeight, h);
+    pageUsed.x = std::max(pageUsed.x, x);
+    pageUsed.y = std::max(pageUsed.y, shelfY + h);
+  }
+
+  // Compose and upload the pages (trimmed to the used area)
+  std::vector<sf::Image> pageImages;
+  for (sf::Vector2u size : pageSizes)
+    pageImages.emplace_back(size, sf::Color::Transparent);
+  for (size_t i : order) {
+    Entry &entry = entries[i];
+    if (entry.region.page < 0)
+      continue;
+    blit(pageImages[entry.region.page], entry.image,
+         sf::Vector2u(entry.region.rect.position));
+    entry.image = sf::Image();
+  }
+
+  pages.resize(pageImages.size());
+  for (size_t p = 0; p < pages.size(); ++p) {
+    if (!pages[p].loadFromImage(pageImages[p])) {
+      std::cerr << "Failed to create texture atlas page" << std::endl;
+      clear();
+      return false;
+    }
+  }
+
+  std::cout << "Texture atlas: " << order.size() << " images on "
+            << pages.size() << " page(s)" << std::endl;
+  return !pages.empty();
+}
+
+void TextureAtlas::clear() {
+  entries.clear();
+  pages.clear();
+}
+
+const TextureAtlas::Region &TextureAtlas::getRegion(int id) const {
+  if (id < 0 || id >= static_cast<int>(entries.size()))
+    return noRegion;
+  return entries[id].region;
+}
+
+const sf::Texture *TextureAtlas::getTexture(int id) const {
+  const Region &region = getRegion(id);
+  if (region.page < 0 || region.page >= static_cast<int>(pages.size()))
+    return nullptr;
+  return &pages[region.page];
+}
+
+void TextureAtlas::blit(sf::Image &page, const sf::Image &image,
+                        sf::Vector2u dest) {
+  if (!page.copy(image, dest))
+    return;
+
+  // Extrude the outermost texels into the padding
+  sf::Vector2u size = image.getSize();
+  int w = static_cast<int>(size.x);
+  int h = static_cast<int>(size.y);
+  int pad = static_cast<int>(PADDING);
+  for (int y = -pad; y < h + pad; ++y) {
+    for (int x = -pad; x < w + pad; ++x) {
+      if (x >= 0 && x < w && y >= 0 && y < h) {
+        x = w - 1; // skip the interior
+        continue;
+      }
+      sf::Vector2u source(static_cast<unsigned>(std::clamp(x, 0, w - 1)),
+                          static_cast<unsigned>(std::clamp(y, 0, h - 1)));
+      page.setPixel({dest.x + x, dest.y + y}, image.getPixel(source));
+    }
+  }
+}
@@ -1,17 +1,61 @@
 ﻿#include <Game/Entities/Player.hpp>
 #include <Game/World/Map.hpp>
+#include <Game/World/TileNeighborhood.hpp>
 #include <iostream>
 
-Player::Player() : sprite(texture) {
-  if (!texture.loadFromFile("assets/player/spritesheet.png")) {
-    std::cerr << "Failed to load player texture!" << std::endl;
+using Key = sf::Keyboard::Key;
+
+namespace {
+const char *const SpriteSheetFile = "assets/player/spritesheet.png";
+} // namespace
+
+const Player::Controls Player::DefaultControls{
+    {Key::A, Key::Left},  {Key::D, Key::Right}, {Key::W, Key::Up},
+    {Key::S, Key::Down},  {Key::Space, Key::Unknown},
+    {Key::LShift, Key::Unknown}};
+
+const std::array<Player::Controls, 4> Player::SplitControls{{
+    // WASD, Space, Left Shift
+    {{Key::A, Key::Unknown},
+     {Key::D, Key::Unknown},
+     {Key::W, Key::Unknown},
+     {Key::S, Key::Unknown},
+     {Key::Space, Key::Unknown},
+     {Key::LShift, Key::Unknown}},
+    // Arrows, Right Ctrl, Right Shift
+    {{Key::Left, Key::Unknown},
+     {Key::Right, Key::Unknown},
+     {Key::Up, Key::Unknown},
+     {Key::Down, Key::Unknown},
+     {Key::RControl, Key::Unknown},
+     {Key::RShift, Key::Unknown}},
+    // IJKL, U, O
+    {{Key::J, Key::Unknown},
+     {Key::L, Key::Unknown},
+     {Key::I, Key::Unknown},
+     {Key::K, Key::Unknown},
+     {Key::U, Key::Unknown},
+     {Key::O, Key::Unknown}},
+    // Numpad 8456, Numpad 0, Numpad +
+    {{Key::Numpad4, Key::Unknown},
+     {Key::Numpad6, Key::Unknown},
+     {Key::Numpad8, Key::Unknown},
+     {Key::Numpad5, Key::Unknown},
+     {Key::Numpad0, Key::Unknown},
+     {Key::Add, Key::Unknown}},
+}};
+
+bool Player::isDown(const Controls::Keys &keys) {
+  for (Key key : keys) {
+    if (key != Key::Unknown && sf::Keyboard::isKeyPressed(key))
+      return true;
   }
-  sprite.setTexture(texture, true);
-
-  sprite.setTextureRect(sf::IntRect({0, 0}, {32, 32}));
+  return false;
+}
 
-  // Set origin to bottom-center for proper positioning relative to hitbox
-  sprite.setOrigin({16.f, 32.f});
+Player::Player() : controls(DefaultControls), sheet(&texture) {
+  atlasId = -1;
+  setFrame(0, 0);
 
   facingRight = true;
 
@@ -30,6 +74,7 @@ Player::Player() : sprite(texture) {
   moveSpeed = 400.f;
   acceleration = 1500.f;
   friction = 1200.f;
+  surfaceFriction = 1.f;
 
   gravity = 1000.f;
   jumpStrength = 500.f;
@@ -69,6 +114,21 @@ Player::Player() : sprite(texture) {
 }
 
 void Player::update(float dt, const Map &map) {
+  // --- Collision Snapshot ---
+  // Fetch the colliders around the swept bounds once; every collision check
+  // of this tick runs against it. The margin covers the wall probes (2px)
+  // and corner correction nudges (6px).
+  const float probeMargin = 8.f;
+  sf::FloatRect sweptArea = getBounds();
+  sf::Vector2f step = velocity * dt;
+  sweptArea.position.x += std::min(step.x, 0.f) - probeMargin;
+  sweptArea.position.y += std::min(step.y, 0.f) - probeMargin;
+  sweptArea.size.x += std::abs(step.x) + 2.f * probeMargin;
+  sweptArea.size.y += std::abs(step.y) + 2.f * probeMargin;
+
+  TileNeighborhood nearby;
+  nearby.capture(map, sweptArea);
+
   // --- Timers ---
   if (dashCooldownTimer > 0.f)
     dashCooldownTimer -= dt;
@@ -94,17 +154,13 @@ void Player::update(float dt, const Map &map) {
   }
 
   // 1. Input Handling & Dynamic Speed (Acceleration/Friction)
-  bool left = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) ||
-              sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A);
-  bool right = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D);
-  bool up = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up) ||
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W);
-  bool down = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down) ||
-              sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S);
-
-  bool jumpPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space);
-  bool dashPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LShift);
+  bool left = isDown(controls.left);
+  bool right = isDown(controls.right);
+  bool up = isDown(controls.up);
+  bool down = isDown(controls.down);
+
+  bool jumpPressed = isDown(controls.jump);
+  bool dashPressed = isDown(controls.dash);
 
   // Buffer the jump input
   bool jumpJustPressed = jumpPressed && !wasJumpPressed;
@@ -191,13 +247,14 @@ void Player::update(float dt, const Map &map) {
     } else if (right && !left) {
       velocity.x += acceleration * dt;
     } else {
-      // Friction
+      // Friction (scaled by the ground material while standing)
+      float currentFriction = friction * (isGrounded ? surfaceFriction : 1.f);
       if (velocity.x > 0) {
-        velocity.x -= friction * dt;
+        velocity.x -= currentFriction * dt;
         if (velocity.x < 0)
           velocity.x = 0;
       } else if (velocity.x < 0) {
-        velocity.x += friction * dt;
+        velocity.x += currentFriction * dt;
         if (velocity.x > 0)
           velocity.x = 0;
       }
@@ -210,14 +267,14 @@ void Player::update(float dt, const Map &map) {
       velocity.x = -currentMaxSpeed;
 
     // 2. Wall Detection Logic
-    sf::FloatRect bounds = shape.getGlobalBounds();
+    sf::FloatRect bounds = getBounds();
     sf::FloatRect leftCheck = bounds;
     leftCheck.position.x -= 2.f;
     sf::FloatRect rightCheck = bounds;
     rightCheck.position.x += 2.f;
 
-    bool touchingLeft = !map.checkCollision(leftCheck).empty();
-    bool touchingRight = !map.checkCollision(rightCheck).empty();
+    bool touchingLeft = nearby.hasCollision(leftCheck);
+    bool touchingRight = nearby.hasCollision(rightCheck);
 
     // Reset wall state
     isWallSliding = false;
@@ -294,143 +351,92 @@ void Player::update(float dt, const Map &map) {
   }
 
   // 5. Physics & Collision Resolution
+  // Move-and-slide: sweep the hitbox along the frame's movement, stop at the
+  // first contact, cancel the velocity along its normal and slide the rest.
+  // Swept tests cannot tunnel, so fast falls need no snapping tolerance.
 
-  // --- X-AXIS ---
-  shape.move({velocity.x * dt, 0.f});
-
-  // Check collisions after X move
-  std::vector<sf::FloatRect> walls =
-      map.checkCollision(shape.getGlobalBounds());
-  for (const auto &wall : walls) {
-    sf::FloatRect playerBounds = shape.getGlobalBounds();
-
-    // Calculate Intersection Overlap using SFML 3 struct members
-    float overlapY = std::min(playerBounds.position.y + playerBounds.size.y,
-                              wall.position.y + wall.size.y) -
-                     std::max(playerBounds.position.y, wall.position.y);
-
-    // Ignore "snagging" on floor/ceiling seams
-    if (overlapY < 5.f)
-      continue;
-
-    // Resolve X collision
-    float playerCenter = shape.getPosition().x + shape.getSize().x / 2.f;
-    float wallCenter = wall.position.x + wall.size.x / 2.f;
-
-    if (velocity.x > 0) { // Moving Right
-      // Only resolve if wall is to the right
-      if (wallCenter > playerCenter) {
-        shape.setPosition(
-            {wall.position.x - shape.getSize().x, shape.getPosition().y});
-        velocity.x = 0; // Stop on wall
-      }
-    } else if (velocity.x < 0) { // Moving Left
-      // Only resolve if wall is to the left
-      if (wallCenter < playerCenter) {
-        shape.setPosition(
-            {wall.position.x + wall.size.x, shape.getPosition().y});
-        velocity.x = 0; // Stop on wall
-      }
-    }
-  }
-
-  // --- Y-AXIS ---
   // Reset grounded (will be set true if we land on something)
   isGrounded = false;
 
-  float prevBottom = shape.getPosition().y + shape.getSize().y;
-  shape.move({0.f, velocity.y * dt});
-
-  // Check collisions after Y move
-  walls = map.checkCollision(shape.getGlobalBounds());
-  for (const auto &wall : walls) {
-    sf::FloatRect playerBounds = shape.getGlobalBounds();
-
-    // Calculate Intersection Overlap X to distinguish Wall from Floor
-    float overlapX = std::min(playerBounds.position.x + playerBounds.size.x,
-                              wall.position.x + wall.size.x) -
-                     std::max(playerBounds.position.x, wall.position.x);
-
-    // Ignore walls (vertical surfaces) when resolving Y collisions
-    if (overlapX < 2.f)
-      continue;
-
-    // Resolve Y collision
-    if (velocity.y > 0) { // Falling
-      // Only snap to top if we were previously ABOVE the wall
-      // Tolerance allows for fast falling, but prevents snapping from
-      // side/bottom
-      if (prevBottom > wall.position.y + 15.f)
-        continue;
-
-      shape.setPosition(
-          {shape.getPosition().x, wall.position.y - shape.getSize().y});
+  // Check if player wants to drop through one-way platforms (S key)
+  bool dropPressed = isDown(controls.down);
+
+  uint8_t mask = Map::CollisionWall;
+  if (velocity.y >= 0 && !dropPressed)
+    mask |= Map::CollisionPlatform;
+
+  sf::FloatRect box = getBounds();
+  sf::Vector2f remaining = velocity * dt;
+  bool cornerCorrected = false;
+
+  const int maxSlides = 4; // enough for a wall, a floor and a corner nudge
+  for (int i = 0; i < maxSlides; ++i) {
+    if (remaining.x == 0.f && remaining.y == 0.f)
+      break;
+
+    Map::SweepHit hit = nearby.sweep(box, remaining, mask);
+    box.position += remaining * hit.time;
+    if (!hit.hit)
+      break;
+    remaining *= 1.f - hit.time;
+
+    const sf::FloatRect &c = hit.collider;
+    if (hit.normal.x != 0.f) {
+      // Wall: stop horizontally, keep falling/rising
+      box.position.x = (hit.normal.x < 0.f) ? c.position.x - box.size.x
+                                            : c.position.x + c.size.x;
+      velocity.x = 0;
+      remaining.x = 0.f;
+    } else if (hit.normal.y < 0.f) {
+      // Floor or platform: land on top
+      box.position.y = c.position.y - box.size.y;
       velocity.y = 0.f;
+      remaining.y = 0.f;
       isGrounded = true;
-    } else if (velocity.y < 0) { // Jumping up
-      // Upwards Corner Correction: Try to wiggle player horizontally
-      const float cornerMargin = 6.f; // Pixels to check for nudge
-      sf::FloatRect playerBounds = shape.getGlobalBounds();
 
-      // Check if we can nudge left
-      sf::FloatRect nudgeLeft = playerBounds;
-      nudgeLeft.position.x -= cornerMargin;
-      if (map.checkCollision(nudgeLeft).empty()) {
-        shape.move({-cornerMargin, 0.f});
-      } else {
-        // Check if we can nudge right
-        sf::FloatRect nudgeRight = playerBounds;
-        nudgeRight.position.x += cornerMargin;
-        if (map.checkCollision(nudgeRight).empty()) {
-          shape.move({cornerMargin, 0.f});
-        } else {
-          // Can't nudge, stop upward movement
-          shape.setPosition(
-              {shape.getPosition().x, wall.position.y + wall.size.y});
-          velocity.y = 0.f;
+      // Material of the tile under the player's center
+      float footX = std::clamp(box.position.x + box.size.x / 2.f,
+                               c.position.x, c.position.x + c.size.x - 1.f);
+      surfaceFriction =
+          map.getTilePropertiesAt(static_cast<int>(footX / Map::TILE_SIZE),
+                                  static_cast<int>(c.position.y /
+                                                   Map::TILE_SIZE))
+              .friction;
+    } else {
+      // Ceiling: Upwards Corner Correction, try to wiggle player horizontally
+      const float cornerMargin = 6.f; // Pixels to check for nudge
+      bool nudged = false;
+      if (!cornerCorrected) {
+        // Area the rest of the jump would cover
+        sf::FloatRect path = Map::getSweptBounds(box, {0.f, remaining.y});
+        path.position += {Map::SWEEP_SKIN, Map::SWEEP_SKIN};
+        path.size -= {2.f * Map::SWEEP_SKIN, 2.f * Map::SWEEP_SKIN};
+
+        for (float nudge : {-cornerMargin, cornerMargin}) {
+          sf::FloatRect shifted = path;
+          shifted.position.x += nudge;
+          if (!nearby.hasCollision(shifted)) {
+            box.position.x += nudge;
+            nudged = true;
+            break;
+          }
         }
+        cornerCorrected = true;
       }
-    }
-  }
-
-  // --- ONE-WAY PLATFORMS ---
-  // Check if player wants to drop through (S key)
-  bool dropPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S) ||
-                     sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down);
-
-  // Only check platforms if falling and not pressing drop
-  if (velocity.y >= 0 && !dropPressed) {
-    std::vector<sf::FloatRect> platforms =
-        map.checkPlatformCollision(shape.getGlobalBounds());
-
-    for (const auto &platform : platforms) {
-      sf::FloatRect playerBounds = shape.getGlobalBounds();
-
-      // Calculate overlap X to ensure we're actually on the platform
-      float overlapX = std::min(playerBounds.position.x + playerBounds.size.x,
-                                platform.position.x + platform.size.x) -
-                       std::max(playerBounds.position.x, platform.position.x);
 
-      // Need sufficient horizontal overlap
-      if (overlapX < 4.f)
-        continue;
-
-      // Only land if we were ABOVE the platform before this frame
-      if (prevBottom <= platform.position.y + 4.f) {
-        shape.setPosition(
-            {shape.getPosition().x, platform.position.y - shape.getSize().y});
+      if (!nudged) {
+        // Can't nudge, stop upward movement
+        box.position.y = c.position.y + c.size.y;
         velocity.y = 0.f;
-        isGrounded = true;
-        break; // Only land on one platform
+        remaining.y = 0.f;
       }
     }
   }
 
+  shape.setPosition(box.position);
+
   bool isMoving = std::abs(velocity.x) > 10.f;
-  bool inputActive = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) ||
-                     sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) ||
-                     sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) ||
-                     sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D);
+  bool inputActive = isDown(controls.left) || isDown(controls.right);
 
   if (isGrounded && !isWallSliding) {
     if (!isMoving && !inputActive) {
@@ -453,7 +459,7 @@ void Player::update(float dt, const Map &map) {
           animationTimer = 0.f;
         }
 
-        sprite.setTextureRect(sf::IntRect({currentFrame * 32, 96}, {32, 32}));
+        setFrame(currentFrame, 3);
       } else {
         animationTimer += dt;
         float frameDelay = (currentFrame == 0) ? 2.0f : 0.5f;
@@ -462,7 +468,7 @@ void Player::update(float dt, const Map &map) {
           animationTimer = 0.f;
           currentFrame = (currentFrame + 1) % 2;
         }
-        sprite.setTextureRect(sf::IntRect({currentFrame * 32, 0}, {32, 32}));
+        setFrame(currentFrame, 0);
       }
 
     } else if (inputActive && isMoving) {
@@ -487,7 +493,7 @@ void Player::update(float dt, const Map &map) {
             currentFrame = 0;
           }
         }
-        sprite.setTextureRect(sf::IntRect({currentFrame * 32, 32}, {32, 32}));
+        setFrame(currentFrame, 1);
 
       } else {
         float runSpeed = 0.1f;
@@ -496,7 +502,7 @@ void Player::update(float dt, const Map &map) {
           animationTimer = 0.f;
           currentFrame = (currentFrame + 1) % 4;
         }
-        sprite.setTextureRect(sf::IntRect({currentFrame * 32, 64}, {32, 32}));
+        setFrame(currentFrame, 2);
       }
 
     } else {
@@ -513,7 +519,7 @@ void Player::update(float dt, const Map &map) {
         currentFrame = (currentFrame == 0) ? 1 : 0;
       }
 
-      sprite.setTextureRect(sf::IntRect({currentFrame * 32, 96}, {32, 32}));
+      setFrame(currentFrame, 3);
     }
   } else {
     // In air (jumping or falling) - not grounded and not wall sliding
@@ -533,8 +539,7 @@ void Player::update(float dt, const Map &map) {
         currentFrame = (currentFrame + 1) % 2; // 2 frames: jump1, jump2
       }
 
-      sprite.setTextureRect(
-          sf::IntRect({currentFrame * 32, 128}, {32, 32})); // Row 5 = y:128
+      setFrame(currentFrame, 4); // Row 5 = y:128
 
     } else {
       // Going down - Fall animation (row 6, index 5)
@@ -547,14 +552,14 @@ void Player::update(float dt, const Map &map) {
       }
 
       // Keep strictly at frame 0
-      sprite.setTextureRect(sf::IntRect({0, 160}, {32, 32}));
+      setFrame(0, 5);
     }
   }
 
   wasMoving = isMoving;
   sf::Vector2f bottomCenter = {shape.getPosition().x + shape.getSize().x / 2.f,
                                shape.getPosition().y + shape.getSize().y};
-  sprite.setPosition(bottomCenter);
+  spritePosition = bottomCenter;
 
   // Flip Logic
   if (velocity.x > 1.f) {
@@ -562,23 +567,41 @@ void Player::update(float dt, const Map &map) {
   } else if (velocity.x < -1.f) {
     facingRight = false;
   }
+}
 
-  if (facingRight) {
-    sprite.setScale({1.5f, 1.5f});
-  } else {
-    sprite.setScale({-1.5f, 1.5f});
-  }
+void Player::render(SpriteBatch &batch) const {
+  // 1.5x scale around the frame's bottom center, which sits on the hitbox
+  sf::Transform transform;
+  transform.translate(spritePosition)
+      .scale({1.5f, 1.5f})
+      .translate({-16.f, -32.f});
+  batch.draw(*sheet, frameRect, transform, sf::Color::White, 0, !facingRight);
+}
+
+void Player::drawDebug(DebugDraw &debug) const {
+  debug.rect(getBounds(), sf::Color(0, 255, 0, 100), sf::Color::Green);
+}
+
+void Player::addToAtlas(TextureAtlas &atlas) {
+  atlasId = atlas.add(SpriteSheetFile);
 }
 
-void Player::render(sf::RenderWindow &window, bool showHitbox) {
-  window.draw(sprite);
-  if (showHitbox) {
-    sf::RectangleShape hitboxVis = shape;
-    hitboxVis.setFillColor(sf::Color(0, 255, 0, 100)); // Semi-transparent green
-    hitboxVis.setOutlineColor(sf::Color::Green);
-    hitboxVis.setOutlineThickness(1.f);
-    window.draw(hitboxVis);
+void Player::useAtlas(const TextureAtlas &atlas) {
+  const sf::Texture *page = atlas.getTexture(atlasId);
+  if (page) {
+    texture = sf::Texture();
+  } else if (texture.getSize().x == 0 &&
+             !texture.loadFromFile(SpriteSheetFile)) {
+    std::cerr << "Failed to load player texture!" << std::endl;
   }
+  sheet = page ? page : &texture;
+  sheetOrigin = page ? atlas.getRegion(atlasId).rect.position : sf::Vector2i();
+  setFrame(0, 0);
+}
+
+void Player::setFrame(int column, int row) {
+  frameRect =
+      sf::IntRect(sheetOrigin + sf::Vector2i(column * 32, row * 32), {32, 32});
 }
 
 void Player::reset(sf::Vector2f position) {
@@ -1,11 +1,19 @@
 #include <Game/Game.hpp>
 #include <Game/States/MenuState.hpp>
+#include <iostream>
 
 const sf::Time Game::TimePerFrame = sf::seconds(1.f / 60.f);
+const std::string Game::FontFile = "assets/fonts/font.ttf";
 
 Game::Game() : mWindow(sf::VideoMode({1280, 720}), "Journey to the Clouds") {
   mWindow.setFramerateLimit(60);
   mWindow.setVerticalSyncEnabled(true);
+
+  // Rasterize the glyphs of every text size up front, so the first frame of
+  // the HUD or the pause menu does not stall: map hints (12), HUD (14), menu
+  // buttons (30) and the pause title (50)
+  mFonts.prewarm(FontFile, {{12, 1.f}, {14, 1.5f}, {30, 1.f}, {50}});
+
   mStates.push_back(std::make_unique<MenuState>(this));
 }
 
@@ -93,11 +101,34 @@ void Game::update(sf::Time dt) {
 
 void Game::render() {
   mWindow.clear(sf::Color::Black);
-  for (const auto &state : mStates)
-    state->render(mWindow);
+  renderStates(mWindow);
   mWindow.display();
 }
 
+void Game::renderStates(sf::RenderTarget &target) {
+  // Start at the topmost opaque state, everything below it is hidden
+  size_t first = 0;
+  for (size_t i = mStates.size(); i-- > 0;) {
+    if (mStates[i]->isOpaque()) {
+      first = i;
+      break;
+    }
+  }
+  for (size_t i = first; i < mStates.size(); ++i)
+    mStates[i]->render(target);
+}
+
+bool Game::captureFrame(sf::RenderTexture &texture) {
+  if (!texture.resize(mWindow.getSize())) {
+    std::cerr << "Failed to create frame snapshot" << std::endl;
+    return false;
+  }
+  texture.clear(sf::Color::Black);
+  renderStates(texture);
+  texture.display();
+  return true;
+}
+
 void Game::cycleWindowMode() {
   mWindowMode = (mWindowMode + 1) % 3;
 
@@ -5,9 +5,10 @@
 #include <iostream>
 
 GameState::GameState(Game *game)
-    : State(game), mCamera({0.f, 0.f}, {960.f, 540.f}), mPlayer(), mMap(),
+    : State(game), mCamera({0.f, 0.f}, CameraSize), mPlayer(), mMap(),
       mBackgroundSprite(mBackgroundTexture), mShowHitbox(false),
-      mShowFPS(false), mFrameCount(0), mCurrentFPS(0), mResetTimer(0.f),
+      mShowFPS(false), mFPSFont(game->getFonts().get(Game::FontFile)),
+      mFrameCount(0), mCurrentFPS(0), mHud(mFPSFont), mResetTimer(0.f),
       mIsResetting(false), mDeathPhase(0), mDeathTimer(0.f),
       mCurrentLevelIndex(0) {
 
@@ -19,7 +20,11 @@ GameState::GameState(Game *game)
   mBackgroundTexture.setRepeated(true);
   mBackgroundSprite.setTexture(mBackgroundTexture);
 
-  mFPSFontLoaded = mFPSFont.openFromFile("assets/fonts/font.ttf");
+  mFPSFontLoaded = mGame->getFonts().isLoaded(Game::FontFile);
+  if (mFPSFontLoaded) {
+    mMap.setFont(mFPSFont);
+    mDebugDraw.setFont(mFPSFont);
+  }
 
   mLevels = {"assets/maps/test.tmx"};
   loadLevel(mLevels[mCurrentLevelIndex]);
@@ -27,22 +32,103 @@ GameState::GameState(Game *game)
 
 void GameState::loadLevel(const std::string &filename) {
   if (mMap.loadFromFile(filename)) {
+    // Pack the tilesets and the player sprite sheet into shared textures
+    mAtlas.clear();
+    mMap.addToAtlas(mAtlas);
+    mPlayer.addToAtlas(mAtlas);
+    mAtlas.build();
+    mMap.useAtlas(mAtlas);
+    mPlayer.useAtlas(mAtlas);
+
     mPlayer.reset(mMap.getStartPosition());
-    sf::Vector2f playerPos = mPlayer.getPosition();
-    sf::Vector2f viewSize = mCamera.getSize();
-    float mapW = mMap.getWidth();
-    float mapH = mMap.getHeight();
-
-    float camX =
-        std::clamp(playerPos.x, viewSize.x / 2.f, mapW - viewSize.x / 2.f);
-    float camY =
-        std::clamp(playerPos.y, viewSize.y / 2.f, mapH - viewSize.y / 2.f);
-    mCamera.setCenter({camX, camY});
+    for (auto &split : mSplitPlayers) {
+      split->player.addToAtlas(mAtlas); // already packed, looks up its ID
+      split->player.useAtlas(mAtlas);
+      split->player.reset(mMap.getStartPosition());
+    }
+    setZoom(mZoom);
+    mCamera.setCenter(getCameraTarget(mCamera, mPlayer.getPosition()));
+    for (auto &split : mSplitPlayers)
+      split->camera.setCenter(
+          getCameraTarget(split->camera, split->player.getPosition()));
+    mMinimap.build(mMap, mPlayer.getPosition());
   } else {
     std::cerr << "Failed to load level: " << filename << std::endl;
   }
 }
 
+void GameState::setZoom(float zoom) {
+  // Zoom out at most until the whole level fits on screen
+  float fit = std::max(mMap.getWidth() / CameraSize.x,
+                       mMap.getHeight() / CameraSize.y);
+  float maxZoom = 1.f;
+  while (maxZoom < fit)
+    maxZoom *= 2.f;
+
+  mZoom = std::clamp(zoom, 1.f, maxZoom);
+  updateViewports();
+}
+
+void GameState::setPlayerCount(int count) {
+  count = std::clamp(count, 1, MaxPlayers);
+  mSplitPlayers.resize(std::min<size_t>(mSplitPlayers.size(), count - 1));
+  while (static_cast<int>(mSplitPlayers.size()) < count - 1) {
+    // The sprite sheet is already packed, so this only looks up its region
+    auto split = std::make_unique<SplitPlayer>();
+    split->player.addToAtlas(mAtlas);
+    split->player.useAtlas(mAtlas);
+    split->player.reset(mMap.getStartPosition());
+    mSplitPlayers.push_back(std::move(split));
+  }
+
+  // Alone, player one may use either key set
+  mPlayer.setControls(count == 1 ? Player::DefaultControls
+                                 : Player::SplitControls[0]);
+  for (size_t i = 0; i < mSplitPlayers.size(); ++i)
+    mSplitPlayers[i]->player.setControls(Player::SplitControls[i + 1]);
+
+  updateViewports();
+  for (auto &split : mSplitPlayers)
+    split->camera.setCenter(
+        getCameraTarget(split->camera, split->player.getPosition()));
+}
+
+void GameState::updateViewports() {
+  int count = static_cast<int>(mSplitPlayers.size()) + 1;
+  auto viewport = [count](int index) {
+    if (count == 1)
+      return sf::FloatRect({0.f, 0.f}, {1.f, 1.f});
+    if (count == 2)
+      return sf::FloatRect({0.5f * index, 0.f}, {0.5f, 1.f});
+    return sf::FloatRect({0.5f * (index % 2), 0.5f * (index / 2)},
+                         {0.5f, 0.5f});
+  };
+  auto apply = [this](sf::View &camera, const sf::FloatRect &rect) {
+    camera.setViewport(rect);
+    camera.setSize(CameraSize.componentWiseMul(rect.size) * mZoom);
+  };
+
+  apply(mCamera, viewport(0));
+  for (size_t i = 0; i < mSplitPlayers.size(); ++i)
+    apply(mSplitPlayers[i]->camera, viewport(static_cast<int>(i) + 1));
+}
+
+sf::Vector2f GameState::getCameraTarget(const sf::View &camera,
+                                        sf::Vector2f focus) const {
+  // Follow focus but keep the view inside the map, or center the map if the
+  // view is larger than it
+  sf::Vector2f viewSize = camera.getSize();
+  float mapW = mMap.getWidth();
+  float mapH = mMap.getHeight();
+  float targetX = (mapW < viewSize.x) ? mapW / 2.f
+                                      : std::clamp(focus.x, viewSize.x / 2.f,
+                                                   mapW - viewSize.x / 2.f);
+  float targetY = (mapH < viewSize.y) ? mapH / 2.f
+                                      : std::clamp(focus.y, viewSize.y / 2.f,
+                                                   mapH - viewSize.y / 2.f);
+  return {targetX, targetY};
+}
+
 void GameState::handleInput(sf::Event &event) {
   if (const auto *keyPress = event.getIf<sf::Event::KeyPressed>()) {
     if (keyPress->code == sf::Keyboard::Key::Escape)
@@ -51,6 +137,19 @@ void GameState::handleInput(sf::Event &event) {
       mShowFPS = !mShowFPS;
     if (keyPress->code == sf::Keyboard::Key::F1)
       mShowHitbox = !mShowHitbox;
+    if (keyPress->code == sf::Keyboard::Key::F3)
+      mMap.setChunkCaching(!mMap.isChunkCaching());
+    if (keyPress->code == sf::Keyboard::Key::M)
+      mShowMinimap = !mShowMinimap;
+    if (keyPress->code == sf::Keyboard::Key::F5)
+      setPlayerCount(static_cast<int>(mSplitPlayers.size() + 1) % MaxPlayers +
+                     1);
+    if (keyPress->code == sf::Keyboard::Key::F6)
+      mPixelPerfect = !mPixelPerfect;
+    if (keyPress->code == sf::Keyboard::Key::Hyphen)
+      setZoom(mZoom * 2.f);
+    if (keyPress->code == sf::Keyboard::Key::Equal)
+      setZoom(mZoom / 2.f);
   }
 }
 
@@ -71,6 +170,8 @@ void GameState::update(sf::Time dt) {
     } else {
       if (!mIsResetting) {
         mPlayer.reset(mMap.getStartPosition());
+        for (auto &split : mSplitPlayers)
+          split->player.reset(mMap.getStartPosition());
         mIsResetting = true;
       }
       alpha = 255.f - ((mResetTimer - 1.0f) / 1.0f) * 255.f;
@@ -117,20 +218,7 @@ void GameState::update(sf::Time dt) {
           sf::Color(0, 0, 0, static_cast<uint8_t>(progress * 255.f)));
 
       // Camera lerps toward death position
-      sf::Vector2f currentCenter = mCamera.getCenter();
-      sf::Vector2f viewSize = mCamera.getSize();
-      float mapW = mMap.getWidth();
-      float mapH = mMap.getHeight();
-      float targetX = std::clamp(mDeathPosition.x, viewSize.x / 2.f,
-                                 mapW - viewSize.x / 2.f);
-      float targetY = std::clamp(mDeathPosition.y, viewSize.y / 2.f,
-                                 mapH - viewSize.y / 2.f);
-      float lerpSpeed = 8.0f;
-      float newX = currentCenter.x +
-                   (targetX - currentCenter.x) * lerpSpeed * dt.asSeconds();
-      float newY = currentCenter.y +
-                   (targetY - currentCenter.y) * lerpSpeed * dt.asSeconds();
-      mCamera.setCenter({std::round(newX), std::round(newY)});
+      followFocus(mCamera, mDeathPosition, 8.0f, dt);
 
       if (mDeathTimer <= 0.f) {
         mDeathPhase = 2;
@@ -142,15 +230,7 @@ void GameState::update(sf::Time dt) {
       // Phase 2: Hold black, snap camera to player
       mFadeOverlay.setFillColor(sf::Color(0, 0, 0, 255));
 
-      sf::Vector2f playerPos = mPlayer.getPosition();
-      sf::Vector2f viewSize = mCamera.getSize();
-      float mapW = mMap.getWidth();
-      float mapH = mMap.getHeight();
-      float camX =
-          std::clamp(playerPos.x, viewSize.x / 2.f, mapW - viewSize.x / 2.f);
-      float camY =
-          std::clamp(playerPos.y, viewSize.y / 2.f, mapH - viewSize.y / 2.f);
-      mCamera.setCenter({camX, camY});
+      mCamera.setCenter(getCameraTarget(mCamera, mPlayer.getPosition()));
 
       if (mDeathTimer <= 0.f) {
         mDeathPhase = 3;
@@ -164,25 +244,7 @@ void GameState::update(sf::Time dt) {
           sf::Color(0, 0, 0, static_cast<uint8_t>(progress * 255.f)));
 
       // Camera follows player
-      sf::Vector2f playerPos = mPlayer.getPosition();
-      sf::Vector2f viewSize = mCamera.getSize();
-      sf::Vector2f currentCenter = mCamera.getCenter();
-      float mapW = mMap.getWidth();
-      float mapH = mMap.getHeight();
-      float targetX = (mapW < viewSize.x)
-                          ? mapW / 2.f
-                          : std::clamp(playerPos.x, viewSize.x / 2.f,
-                                       mapW - viewSize.x / 2.f);
-      float targetY = (mapH < viewSize.y)
-                          ? mapH / 2.f
-                          : std::clamp(playerPos.y, viewSize.y / 2.f,
-                                       mapH - viewSize.y / 2.f);
-      float lerpSpeed = 5.0f;
-      float newX = currentCenter.x +
-                   (targetX - currentCenter.x) * lerpSpeed * dt.asSeconds();
-      float newY = currentCenter.y +
-                   (targetY - currentCenter.y) * lerpSpeed * dt.asSeconds();
-      mCamera.setCenter({std::round(newX), std::round(newY)});
+      followFocus(mCamera, mPlayer.getPosition(), 5.0f, dt);
 
       if (mDeathTimer <= 0.f) {
         mDeathPhase = 0;
@@ -208,67 +270,108 @@ void GameState::update(sf::Time dt) {
     }
 
     // Finish
-    if (mMap.checkFinish(mPlayer.getBounds())) {
-      std::cout << "Level Finished!" << std::endl;
-      if (mCurrentLevelIndex + 1 < mLevels.size()) {
-        mCurrentLevelIndex++;
-        loadLevel(mLevels[mCurrentLevelIndex]);
-      } else {
-        std::cout << "Game Completed! Looping back to start." << std::endl;
-        mCurrentLevelIndex = 0;
-        loadLevel(mLevels[mCurrentLevelIndex]);
-      }
-    }
+    if (mMap.checkFinish(mPlayer.getBounds()))
+      finishLevel();
 
     // Camera
-    sf::Vector2f playerPos = mPlayer.getPosition();
-    sf::Vector2f viewSize = mCamera.getSize();
-    sf::Vector2f currentCenter = mCamera.getCenter();
-    float mapW = mMap.getWidth();
-    float mapH = mMap.getHeight();
-    float targetX = (mapW < viewSize.x)
-                        ? mapW / 2.f
-                        : std::clamp(playerPos.x, viewSize.x / 2.f,
-                                     mapW - viewSize.x / 2.f);
-    float targetY = (mapH < viewSize.y)
-                        ? mapH / 2.f
-                        : std::clamp(playerPos.y, viewSize.y / 2.f,
-                                     mapH - viewSize.y / 2.f);
-    float lerpSpeed = 5.0f;
-    float newX = currentCenter.x +
-                 (targetX - currentCenter.x) * lerpSpeed * dt.asSeconds();
-    float newY = currentCenter.y +
-                 (targetY - currentCenter.y) * lerpSpeed * dt.asSeconds();
-    mCamera.setCenter({std::round(newX), std::round(newY)});
+    followFocus(mCamera, mPlayer.getPosition(), 5.0f, dt);
+    prefetchAhead(mCamera, mPlayer.getVelocity());
   }
-}
 
-void GameState::render(sf::RenderWindow &window) {
-  window.setView(mCamera);
+  // Split-screen players keep playing while player one respawns
+  for (auto &split : mSplitPlayers) {
+    Player &player = split->player;
+    player.update(dt.asSeconds(), mMap);
+    if (player.getPosition().y > mMap.getHeight() + 200.f ||
+        mMap.checkSpikeCollision(player.getBounds())) {
+      player.reset(mMap.getStartPosition());
+      split->camera.setCenter(
+          getCameraTarget(split->camera, player.getPosition()));
+    }
+    if (mMap.checkFinish(player.getBounds())) {
+      finishLevel();
+      break;
+    }
 
-  // Parallax Background
-  sf::Vector2f cameraCenter = mCamera.getCenter();
-  sf::Vector2f viewSize = mCamera.getSize();
+    followFocus(split->camera, player.getPosition(), 5.0f, dt);
+    prefetchAhead(split->camera, player.getVelocity());
+  }
 
-  mBackgroundSprite.setPosition(
-      {cameraCenter.x - viewSize.x / 2.f, cameraCenter.y - viewSize.y / 2.f});
+  mMap.updateAnimations(dt);
+  if (mShowMinimap)
+    mMinimap.update(mMap, mPlayer.getPosition());
+}
 
-  float parallaxFactorX = 0.2f;
-  float parallaxFactorY = 0.1f;
+void GameState::finishLevel() {
+  std::cout << "Level Finished!" << std::endl;
+  if (mCurrentLevelIndex + 1 < mLevels.size()) {
+    mCurrentLevelIndex++;
+    loadLevel(mLevels[mCurrentLevelIndex]);
+  } else {
+    std::cout << "Game Completed! Looping back to start." << std::endl;
+    mCurrentLevelIndex = 0;
+    loadLevel(mLevels[mCurrentLevelIndex]);
+  }
+}
 
-  int texX = static_cast<int>(cameraCenter.x * parallaxFactorX);
-  int texY = static_cast<int>(cameraCenter.y * parallaxFactorY);
-  mBackgroundSprite.setTextureRect(
-      sf::IntRect({texX, texY}, {static_cast<int>(viewSize.x) + 2,
-                                 static_cast<int>(viewSize.y) + 2}));
+void GameState::followFocus(sf::View &camera, sf::Vector2f focus,
+                            float lerpSpeed, sf::Time dt) const {
+  sf::Vector2f currentCenter = camera.getCenter();
+  sf::Vector2f target = getCameraTarget(camera, focus);
+  float newX = currentCenter.x +
+               (target.x - currentCenter.x) * lerpSpeed * dt.asSeconds();
+  float newY = currentCenter.y +
+               (target.y - currentCenter.y) * lerpSpeed * dt.asSeconds();
+  camera.setCenter({std::round(newX), std::round(newY)});
+}
 
-  window.draw(mBackgroundSprite);
-  mMap.render(window, mPlayer.getPosition(), mShowHitbox);
-  mPlayer.render(window, mShowHitbox);
+void GameState::prefetchAhead(const sf::View &camera, sf::Vector2f velocity) {
+  const float prefetchLookAhead = 0.5f; // seconds
+  sf::Vector2f viewSize = camera.getSize();
+  sf::Vector2f predictedCenter =
+      camera.getCenter() + velocity * prefetchLookAhead;
+  mMap.prefetchChunks(
+      sf::FloatRect(predictedCenter - viewSize / 2.f, viewSize));
+}
+
+void GameState::render(sf::RenderTarget &window) {
+  // In pixel-perfect mode the world goes to the small texture first
+  if (mPixelPerfect && mWorldTarget.getSize() != NativeResolution &&
+      !mWorldTarget.resize(NativeResolution)) {
+    std::cerr << "Failed to create native resolution target" << std::endl;
+    mPixelPerfect = false;
+  }
+  sf::RenderTarget &worldTarget =
+      mPixelPerfect ? static_cast<sf::RenderTarget &>(mWorldTarget) : window;
+  if (mPixelPerfect)
+    mWorldTarget.clear(sf::Color::Black);
+
+  // One pass per viewport; chunk geometry and caches are shared by all
+  renderWorld(worldTarget, mCamera, mPlayer.getPosition(), mTextHints);
+  for (const auto &split : mSplitPlayers)
+    renderWorld(worldTarget, split->camera, split->player.getPosition(),
+                split->textHints);
 
-  // Fade overlay
   window.setView(window.getDefaultView());
-  mFadeOverlay.setSize(sf::Vector2f(window.getSize()));
+  sf::FloatRect worldArea({0.f, 0.f}, sf::Vector2f(window.getSize()));
+  if (mPixelPerfect) {
+    mWorldTarget.display();
+    worldArea = presentWorld(window);
+  }
+
+  // Player one's viewport in window pixels
+  const sf::FloatRect &viewport = mCamera.getViewport();
+  sf::FloatRect playerArea(
+      worldArea.position + viewport.position.componentWiseMul(worldArea.size),
+      viewport.size.componentWiseMul(worldArea.size));
+
+  // The minimap follows player one, so it stays inside their viewport
+  if (mShowMinimap)
+    mMinimap.render(window, playerArea);
+
+  // Fade overlay (over player one's viewport)
+  mFadeOverlay.setPosition(playerArea.position);
+  mFadeOverlay.setSize(playerArea.size);
   window.draw(mFadeOverlay);
 
   // FPS counter
@@ -282,97 +385,68 @@ void GameState::render(sf::RenderWindow &window) {
 
   if (mShowFPS && mFPSFontLoaded) {
     window.setView(window.getDefaultView());
+    mHud.update(mCurrentFPS, mShowHitbox, mGame->getWindowMode(), mPlayer);
+    mHud.render(window);
+  }
+}
 
-    // 1. FPS Text
-    sf::Text fpsText(mFPSFont);
-    fpsText.setString("FPS: " + std::to_string(mCurrentFPS));
-    fpsText.setCharacterSize(14);
-
-    sf::Color fpsColor;
-    if (mCurrentFPS >= 60) {
-      fpsColor = sf::Color::Green;
-    } else if (mCurrentFPS >= 30) {
-      float factor = (mCurrentFPS - 30.f) / 30.f;
-      fpsColor =
-          sf::Color(static_cast<unsigned char>(255.f * (1.f - factor)), 255, 0);
-    } else {
-      float factor = std::max(0.f, mCurrentFPS / 30.f);
-      fpsColor = sf::Color(255, static_cast<unsigned char>(255.f * factor), 0);
-    }
-    fpsText.setFillColor(fpsColor);
-    fpsText.setOutlineColor(sf::Color::Black);
-    fpsText.setOutlineThickness(1.5f);
-    fpsText.setPosition({10.f, 10.f});
-    window.draw(fpsText);
-
-    // 2. Hitboxes Text
-    sf::Text hitboxText(mFPSFont);
-    hitboxText.setString("Hitboxes: " +
-                         std::string(mShowHitbox ? "ON" : "OFF"));
-    hitboxText.setCharacterSize(14);
-    hitboxText.setFillColor(mShowHitbox ? sf::Color::Green : sf::Color::Red);
-    hitboxText.setOutlineColor(sf::Color::Black);
-    hitboxText.setOutlineThickness(1.5f);
-    hitboxText.setPosition({10.f, fpsText.getPosition().y +
-                                      fpsText.getGlobalBounds().size.y + 5.f});
-    window.draw(hitboxText);
-
-    // 3 & 4. Main Stats (Screen Mode, Velocity)
-    std::ostringstream hudText;
-    int wMode = mGame->getWindowMode();
-    hudText << "Screen Mode: "
-            << (wMode == 0 ? "Windowed"
-                           : (wMode == 1 ? "Maximized" : "Fullscreen"))
-            << "\n";
-    sf::Vector2f vel = mPlayer.getVelocity();
-    hudText << std::fixed << std::setprecision(1);
-    hudText << "Velocity: X=" << vel.x << " Y=" << vel.y;
-
-    sf::Text statsText(mFPSFont);
-    statsText.setString(hudText.str());
-    statsText.setCharacterSize(14);
-    statsText.setFillColor(sf::Color::White);
-    statsText.setOutlineColor(sf::Color::Black);
-    statsText.setOutlineThickness(1.5f);
-    statsText.setPosition({10.f, hitboxText.getPosition().y +
-                                     hitboxText.getGlobalBounds().size.y +
-                                     5.f});
-    window.draw(statsText);
-
-    // 5. Dash Ready Text
-    bool dashReady = mPlayer.getDashCooldownTimer() <= 0.f &&
-                     (mPlayer.getIsGrounded() || mPlayer.getHasAirDash());
-
-    sf::Text dashText(mFPSFont);
-    dashText.setString("Dash Ready: " + std::string(dashReady ? "YES" : "NO"));
-    dashText.setCharacterSize(14);
-    dashText.setFillColor(dashReady ? sf::Color::Green : sf::Color::Red);
-    dashText.setOutlineColor(sf::Color::Black);
-    dashText.setOutlineThickness(1.5f);
-    dashText.setPosition({10.f, statsText.getPosition().y +
-                                    statsText.getGlobalBounds().size.y + 5.f});
-    window.draw(dashText);
-
-    // 6. Player State Text
-    std::string stateStr = "Idle";
-    if (mPlayer.getIsDashing())
-      stateStr = "Dash";
-    else if (!mPlayer.getIsGrounded()) {
-      if (mPlayer.getIsWallSliding())
-        stateStr = "Wall Slide";
-      else
-        stateStr = "Jump/Fall";
-    } else if (std::abs(vel.x) > 0.1f)
-      stateStr = "Run";
-
-    sf::Text stateText(mFPSFont);
-    stateText.setString("State: " + stateStr);
-    stateText.setCharacterSize(14);
-    stateText.setFillColor(sf::Color::Cyan);
-    stateText.setOutlineColor(sf::Color::Black);
-    stateText.setOutlineThickness(1.5f);
-    stateText.setPosition({10.f, dashText.getPosition().y +
-                                     dashText.getGlobalBounds().size.y + 5.f});
-    window.draw(stateText);
+sf::FloatRect GameState::presentWorld(sf::RenderTarget &window) {
+  sf::Vector2f screenSize(window.getSize());
+  sf::Vector2f nativeSize(NativeResolution);
+  float fit =
+      std::min(screenSize.x / nativeSize.x, screenSize.y / nativeSize.y);
+
+  // Whole multiples keep every texel the same size. If that wastes a large
+  // part of the window (or the window is smaller than the native
+  // resolution), nearest-neighbor at the fractional fit is used instead:
+  // some texel rows and columns come out one pixel wider, but the screen
+  // is filled.
+  float scale = std::floor(fit);
+  if (scale < 1.f || scale < fit * MinIntegerScaleCoverage)
+    scale = fit;
+
+  sf::Sprite world(mWorldTarget.getTexture());
+  world.setScale({scale, scale});
+  world.setPosition({std::round((screenSize.x - nativeSize.x * scale) / 2.f),
+                     std::round((screenSize.y - nativeSize.y * scale) / 2.f)});
+  window.draw(world);
+  return world.getGlobalBounds();
+}
+
+void GameState::renderWorld(sf::RenderTarget &window, const sf::View &camera,
+                            sf::Vector2f focus, Map::TextHintView &hints) {
+  window.setView(camera);
+
+  // Parallax Background
+  sf::Vector2f cameraCenter = camera.getCenter();
+  sf::Vector2f viewSize = camera.getSize();
+
+  mBackgroundSprite.setPosition(
+      {cameraCenter.x - viewSize.x / 2.f, cameraCenter.y - viewSize.y / 2.f});
+
+  float parallaxFactorX = 0.2f;
+  float parallaxFactorY = 0.1f;
+
+  int texX = static_cast<int>(cameraCenter.x * parallaxFactorX);
+  int texY = static_cast<int>(cameraCenter.y * parallaxFactorY);
+  mBackgroundSprite.setTextureRect(
+      sf::IntRect({texX, texY}, {static_cast<int>(viewSize.x) + 2,
+                                 static_cast<int>(viewSize.y) + 2}));
+
+  window.draw(mBackgroundSprite);
+  mMap.render(window, hints, focus, mShowHitbox);
+  mPlayer.render(mSprites);
+  for (const auto &split : mSplitPlayers)
+    split->player.render(mSprites);
+  mSprites.flush(window);
+
+  // Debug overlay, one draw call for everything queued this pass
+  if (mShowHitbox) {
+    mMap.drawDebug(mDebugDraw,
+                   sf::FloatRect(cameraCenter - viewSize / 2.f, viewSize));
+    mPlayer.drawDebug(mDebugDraw);
+    for (const auto &split : mSplitPlayers)
+      split->player.drawDebug(mDebugDraw);
   }
+  mDebugDraw.flush(window);
 }
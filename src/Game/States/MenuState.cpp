@@ -6,16 +6,14 @@
 MenuState::MenuState(Game *game)
     : State(game), mSelectedOptionIndex(0),
       mBackgroundSprite(mBackgroundTexture), mBackgroundOffset({0.f, 0.f}) {
-  if (!mFont.openFromFile("assets/fonts/font.ttf"))
-    std::cerr << "Failed to load font in MenuState!" << std::endl;
-
   if (!mBackgroundTexture.loadFromFile("assets/backgrounds/bg.png"))
     std::cerr << "Failed to load bg.png in MenuState!" << std::endl;
   mBackgroundTexture.setRepeated(true);
   mBackgroundSprite.setTexture(mBackgroundTexture);
 
-  mButtons.emplace_back(mFont, "Start Game", sf::Vector2f{0, 0});
-  mButtons.emplace_back(mFont, "Exit", sf::Vector2f{0, 0});
+  const sf::Font &font = mGame->getFonts().get(Game::FontFile);
+  mButtons.emplace_back(font, "Start Game", sf::Vector2f{0, 0});
+  mButtons.emplace_back(font, "Exit", sf::Vector2f{0, 0});
   mButtons[0].select(true);
 
   mLastWindowSize = mGame->getWindow().getSize();
@@ -101,7 +99,7 @@ void MenuState::update(sf::Time dt) {
   mBackgroundOffset.y += speedY * dt.asSeconds();
 }
 
-void MenuState::render(sf::RenderWindow &window) {
+void MenuState::render(sf::RenderTarget &window) {
   window.setView(window.getDefaultView());
   sf::Vector2f size = window.getDefaultView().getSize();
   window.clear(sf::Color::Black);
@@ -5,24 +5,35 @@
 #include <iostream>
 
 PauseState::PauseState(Game *game)
-    : State(game), mPauseText(mFont), mSelectedOptionIndex(0) {
-  if (!mFont.openFromFile("assets/fonts/font.ttf"))
-    std::cerr << "Failed to load font in PauseState!" << std::endl;
-
+    : State(game), mPauseText(game->getFonts().get(Game::FontFile)),
+      mSnapshotSprite(mSnapshot.getTexture()), mSelectedOptionIndex(0) {
   sf::Vector2f viewSize = mGame->getWindow().getDefaultView().getSize();
   mBackground.setSize(viewSize);
   mBackground.setFillColor(sf::Color(0, 0, 0, 150));
 
-  mPauseText.setFont(mFont);
+  // Freeze the frame below once (with the dimming baked in), so the level
+  // is not rendered again while the game is paused
+  mHasSnapshot = mGame->captureFrame(mSnapshot);
+  if (mHasSnapshot) {
+    // Cover the whole snapshot, which may differ from the view size
+    mBackground.setSize(sf::Vector2f(mSnapshot.getSize()));
+    mSnapshot.setView(mSnapshot.getDefaultView());
+    mSnapshot.draw(mBackground);
+    mSnapshot.display();
+    mSnapshotSprite.setTexture(mSnapshot.getTexture(), true);
+    mBackground.setSize(viewSize);
+  }
+
   mPauseText.setString("PAUSED");
   mPauseText.setCharacterSize(50);
   sf::FloatRect textBounds = mPauseText.getLocalBounds();
   mPauseText.setOrigin({textBounds.size.x / 2.f, textBounds.size.y / 2.f});
   mPauseText.setPosition({viewSize.x / 2.f, viewSize.y / 4.f});
 
-  mButtons.emplace_back(mFont, "Continue", sf::Vector2f{0, 0});
-  mButtons.emplace_back(mFont, "Restart", sf::Vector2f{0, 0});
-  mButtons.emplace_back(mFont, "Main Menu", sf::Vector2f{0, 0});
+  const sf::Font &font = mPauseText.getFont();
+  mButtons.emplace_back(font, "Continue", sf::Vector2f{0, 0});
+  mButtons.emplace_back(font, "Restart", sf::Vector2f{0, 0});
+  mButtons.emplace_back(font, "Main Menu", sf::Vector2f{0, 0});
 
   updateLayout();
   mButtons[0].select(true);
@@ -113,9 +124,18 @@ void PauseState::handleInput(sf::Event &event) {
 
 void PauseState::update(sf::Time dt) {}
 
-void PauseState::render(sf::RenderWindow &window) {
+void PauseState::render(sf::RenderTarget &window) {
   window.setView(window.getDefaultView());
-  window.draw(mBackground);
+  if (mHasSnapshot) {
+    // Stretch to the window in case it was resized while paused
+    sf::Vector2f viewSize = window.getDefaultView().getSize();
+    sf::Vector2f snapshotSize(mSnapshot.getSize());
+    mSnapshotSprite.setScale(
+        {viewSize.x / snapshotSize.x, viewSize.y / snapshotSize.y});
+    window.draw(mSnapshotSprite);
+  } else {
+    window.draw(mBackground);
+  }
   window.draw(mPauseText);
   for (auto &button : mButtons)
     button.render(window);
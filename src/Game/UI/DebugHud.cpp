@@ -0,0 +1,92 @@
+#include <Game/Entities/Player.hpp>
+#include <Game/UI/DebugHud.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+DebugHud::DebugHud(const sf::Font &font)
+    : mFPSText(font, 14, 1.5f), mHitboxText(font, 14, 1.5f),
+      mStatsText(font, 14, 1.5f), mDashText(font, 14, 1.5f),
+      mStateText(font, 14, 1.5f) {
+  mStatsText.setColor(sf::Color::White);
+  mStateText.setColor(sf::Color::Cyan);
+  mFPSText.setPosition({10.f, 10.f});
+}
+
+void DebugHud::update(int fps, bool showHitbox, int windowMode,
+                      const Player &player) {
+  bool changed = false;
+
+  // 1. FPS (green at 60+, fading through yellow to red below 30)
+  mFormat.clear();
+  mFormat << "FPS: " << fps;
+  changed |= mFPSText.setText(mFormat.view());
+  sf::Color fpsColor;
+  if (fps >= 60) {
+    fpsColor = sf::Color::Green;
+  } else if (fps >= 30) {
+    float factor = (fps - 30.f) / 30.f;
+    fpsColor =
+        sf::Color(static_cast<unsigned char>(255.f * (1.f - factor)), 255, 0);
+  } else {
+    float factor = std::max(0.f, fps / 30.f);
+    fpsColor = sf::Color(255, static_cast<unsigned char>(255.f * factor), 0);
+  }
+  mFPSText.setColor(fpsColor);
+
+  // 2. Hitboxes
+  changed |=
+      mHitboxText.setText(showHitbox ? "Hitboxes: ON" : "Hitboxes: OFF");
+  mHitboxText.setColor(showHitbox ? sf::Color::Green : sf::Color::Red);
+
+  // 3 & 4. Screen mode and velocity
+  sf::Vector2f vel = player.getVelocity();
+  mFormat.clear();
+  mFormat << "Screen Mode: "
+          << (windowMode == 0 ? "Windowed"
+                              : (windowMode == 1 ? "Maximized" : "Fullscreen"))
+          << "\nVelocity: X=";
+  mFormat.fixed(vel.x, 1) << " Y=";
+  mFormat.fixed(vel.y, 1);
+  changed |= mStatsText.setText(mFormat.view());
+
+  // 5. Dash ready
+  bool dashReady = player.getDashCooldownTimer() <= 0.f &&
+                   (player.getIsGrounded() || player.getHasAirDash());
+  changed |=
+      mDashText.setText(dashReady ? "Dash Ready: YES" : "Dash Ready: NO");
+  mDashText.setColor(dashReady ? sf::Color::Green : sf::Color::Red);
+
+  // 6. Player state
+  const char *state = "State: Idle";
+  if (player.getIsDashing())
+    state = "State: Dash";
+  else if (!player.getIsGrounded())
+    state =
+        player.getIsWallSliding() ? "State: Wall Slide" : "State: Jump/Fall";
+  else if (std::abs(vel.x) > 0.1f)
+    state = "State: Run";
+  changed |= mStateText.setText(state);
+
+  if (changed)
+    updateLayout();
+}
+
+void DebugHud::updateLayout() {
+  TextWidget *lines[] = {&mFPSText, &mHitboxText, &mStatsText, &mDashText,
+                         &mStateText};
+  for (size_t i = 1; i < std::size(lines); ++i) {
+    const TextWidget &prev = *lines[i - 1];
+    sf::FloatRect bounds = prev.getLocalBounds();
+    lines[i]->setPosition(
+        {10.f, prev.getPosition().y + bounds.size.y + 5.f});
+  }
+}
+
+void DebugHud::render(sf::RenderTarget &target) const {
+  mFPSText.render(target);
+  mHitboxText.render(target);
+  mStatsText.render(target);
+  mDashText.render(target);
+  mStateText.render(target);
+}
@@ -0,0 +1,123 @@
+#include <Game/UI/Minimap.hpp>
+#include <Game/World/Map.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+const float MARGIN = 10.f;
+} // namespace
+
+Minimap::Minimap() {
+  mFrame.setFillColor(sf::Color(0, 0, 0, 140));
+  mFrame.setOutlineColor(sf::Color(255, 255, 255, 160));
+  mFrame.setOutlineThickness(1.f);
+
+  mPlayerMarker.setSize({4.f, 4.f});
+  mPlayerMarker.setOrigin({2.f, 2.f});
+  mPlayerMarker.setFillColor(sf::Color::Green);
+}
+
+void Minimap::build(const Map &map, sf::Vector2f focus) {
+  sf::Vector2i mapTiles(map.getWidthInTiles(), map.getHeightInTiles());
+  sf::Vector2i regionSize(std::min(TEXTURE_TILES.x, mapTiles.x),
+                          std::min(TEXTURE_TILES.y, mapTiles.y));
+  mRegion = sf::IntRect({0, 0}, regionSize);
+  mView = sf::IntRect({0, 0}, {std::min(VIEW_TILES.x, regionSize.x),
+                               std::min(VIEW_TILES.y, regionSize.y)});
+  if (regionSize.x <= 0 || regionSize.y <= 0)
+    return;
+
+  if (!mTexture.resize(sf::Vector2u(regionSize * PIXELS_PER_TILE))) {
+    std::cerr << "Failed to create minimap texture" << std::endl;
+    mRegion = mView = sf::IntRect();
+    return;
+  }
+
+  mFrame.setSize(sf::Vector2f(mView.size * PIXELS_PER_TILE));
+
+  // Start outside the map, so the first update fills the texture
+  mRegion.position = -TEXTURE_TILES;
+  update(map, focus);
+}
+
+void Minimap::update(const Map &map, sf::Vector2f playerPos) {
+  if (mRegion.size.x <= 0 || mRegion.size.y <= 0)
+    return;
+
+  sf::Vector2i mapTiles(map.getWidthInTiles(), map.getHeightInTiles());
+  sf::Vector2f playerTile = playerPos / Map::TILE_SIZE;
+
+  // Shown area centered on the player, kept inside the map
+  sf::Vector2i center(static_cast<int>(playerTile.x),
+                      static_cast<int>(playerTile.y));
+  mView.position.x = std::clamp(center.x - mView.size.x / 2, 0,
+                                mapTiles.x - mView.size.x);
+  mView.position.y = std::clamp(center.y - mView.size.y / 2, 0,
+                                mapTiles.y - mView.size.y);
+
+  // Slide the texture region only once the shown area leaves it
+  sf::Vector2i viewEnd = mView.position + mView.size;
+  sf::Vector2i regionEnd = mRegion.position + mRegion.size;
+  if (mView.position.x < mRegion.position.x ||
+      mView.position.y < mRegion.position.y || viewEnd.x > regionEnd.x ||
+      viewEnd.y > regionEnd.y) {
+    mRegion.position.x = std::clamp(center.x - mRegion.size.x / 2, 0,
+                                    mapTiles.x - mRegion.size.x);
+    mRegion.position.y = std::clamp(center.y - mRegion.size.y / 2, 0,
+                                    mapTiles.y - mRegion.size.y);
+    fillRegion(map);
+  }
+
+  mPlayerMarker.setPosition((playerTile - sf::Vector2f(mView.position)) *
+                            static_cast<float>(PIXELS_PER_TILE));
+}
+
+void Minimap::render(sf::RenderTarget &target,
+                     const sf::FloatRect &area) const {
+  if (mView.size.x <= 0 || mView.size.y <= 0)
+    return;
+
+  sf::RenderStates states;
+  states.transform.translate(
+      {area.position.x + area.size.x - mFrame.getSize().x - MARGIN,
+       area.position.y + MARGIN});
+
+  target.draw(mFrame, states);
+  sf::Sprite tiles(mTexture,
+                   sf::IntRect((mView.position - mRegion.position) *
+                                   PIXELS_PER_TILE,
+                               mView.size * PIXELS_PER_TILE));
+  target.draw(tiles, states);
+  target.draw(mPlayerMarker, states);
+}
+
+void Minimap::fillRegion(const Map &map) {
+  sf::Image image(sf::Vector2u(mRegion.size * PIXELS_PER_TILE),
+                  sf::Color::Transparent);
+  for (int y = 0; y < mRegion.size.y; ++y) {
+    for (int x = 0; x < mRegion.size.x; ++x) {
+      sf::Color color = tileColor(map.getCollisionAt(mRegion.position.x + x,
+                                                     mRegion.position.y + y));
+      if (color.a == 0)
+        continue;
+      for (int py = 0; py < PIXELS_PER_TILE; ++py)
+        for (int px = 0; px < PIXELS_PER_TILE; ++px)
+          image.setPixel({static_cast<unsigned>(x * PIXELS_PER_TILE + px),
+                          static_cast<unsigned>(y * PIXELS_PER_TILE + py)},
+                         color);
+    }
+  }
+  mTexture.update(image);
+}
+
+sf::Color Minimap::tileColor(uint8_t collision) {
+  if (collision & Map::CollisionSpikes)
+    return sf::Color(220, 60, 60);
+  if (collision & Map::CollisionFinish)
+    return sf::Color(255, 210, 60);
+  if (collision & Map::CollisionWall)
+    return sf::Color(200, 200, 200);
+  if (collision & Map::CollisionPlatform)
+    return sf::Color(90, 140, 255);
+  return sf::Color::Transparent;
+}
@@ -0,0 +1,186 @@
+#include <Game/World/ChunkImpostorCache.hpp>
+#include <Game/World/ChunkTextureCache.hpp>
+#include <Game/World/Map.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+constexpr unsigned IMPOSTORS_PER_ROW =
+    ChunkImpostorCache::PAGE_SIZE / ChunkImpostorCache::IMPOSTOR_SIZE;
+constexpr float CHUNK_PIXELS = Map::CHUNK_TILES * Map::TILE_SIZE;
+} // namespace
+
+static_assert(ChunkImpostorCache::IMPOSTOR_SIZE ==
+                  static_cast<unsigned>(CHUNK_PIXELS / Map::LOD_SCALE),
+              "Impostors must not be magnified when they switch in");
+
+void ChunkImpostorCache::clear() {
+  pages.clear();
+  slots.clear();
+  slotByChunk.clear();
+}
+
+int32_t ChunkImpostorCache::getCapacity() {
+  return static_cast<int32_t>(
+      BUDGET / (static_cast<size_t>(IMPOSTOR_SIZE) * IMPOSTOR_SIZE * 4));
+}
+
+sf::Vector2f ChunkImpostorCache::getTilePosition(int32_t slot) {
+  int index = slot % (IMPOSTORS_PER_ROW * IMPOSTORS_PER_ROW);
+  return {static_cast<float>((index % IMPOSTORS_PER_ROW) * IMPOSTOR_SIZE),
+          static_cast<float>((index / IMPOSTORS_PER_ROW) * IMPOSTOR_SIZE)};
+}
+
+void ChunkImpostorCache::render(sf::RenderTarget &target, const Map &map,
+                                ChunkTextureCache &chunkCache,
+                                sf::Vector2i start, sf::Vector2i end) {
+  size_t chunkCount =
+      static_cast<size_t>(map.getChunksX()) * map.getChunksY();
+  if (slotByChunk.size() != chunkCount)
+    slotByChunk.assign(chunkCount, SLOT_MISSING);
+
+  int startX = std::max(0, start.x);
+  int startY = std::max(0, start.y);
+  int endX = std::min(end.x, map.getChunksX());
+  int endY = std::min(end.y, map.getChunksY());
+
+  // Mark the visible impostors as used, so building never evicts them
+  ++useCounter;
+  for (int cy = startY; cy < endY; ++cy) {
+    for (int cx = startX; cx < endX; ++cx) {
+      int32_t slot = slotByChunk[cy * map.getChunksX() + cx];
+      if (slot >= 0)
+        slots[slot].lastUsed = useCounter;
+    }
+  }
+
+  // Build a few missing impostors of the visible area per frame. A failed
+  // build ends building for this frame, but the pages are still drawn.
+  int built = 0;
+  bool building = true;
+  for (int cy = startY; cy < endY && building; ++cy) {
+    for (int cx = startX; cx < endX && building; ++cx) {
+      int32_t &slot = slotByChunk[cy * map.getChunksX() + cx];
+      if (slot != SLOT_MISSING)
+        continue;
+      if (!map.hasVisualTiles(cx, cy)) {
+        slot = SLOT_EMPTY;
+        continue;
+      }
+      if (!build(map, chunkCache, cx, cy))
+        building = false;
+      else
+        building = ++built < BUILDS_PER_FRAME;
+    }
+  }
+
+  // Only the visible impostors are drawn, so the vertex count follows the
+  // view and not the explored area
+  for (Page &page : pages)
+    page.quads.clear();
+  for (int cy = startY; cy < endY; ++cy) {
+    for (int cx = startX; cx < endX; ++cx) {
+      int32_t slot = slotByChunk[cy * map.getChunksX() + cx];
+      if (slot >= 0)
+        appendQuad(cx, cy, slot);
+    }
+  }
+
+  // One draw call per page (pages hold premultiplied colors)
+  for (const Page &page : pages) {
+    if (page.quads.getVertexCount() == 0)
+      continue;
+    sf::RenderStates states(ChunkTextureCache::BlendPremultiplied);
+    states.texture = &page.target->getTexture();
+    target.draw(page.quads, states);
+  }
+}
+
+bool ChunkImpostorCache::build(const Map &map, ChunkTextureCache &chunkCache,
+                               int cx, int cy) {
+  int32_t slot;
+  if (!acquireSlot(slot))
+    return false;
+
+  // Shrink the chunk texture into its tile of the page, replacing whatever
+  // impostor used the tile before
+  Page &page = pages[slot / (IMPOSTORS_PER_ROW * IMPOSTORS_PER_ROW)];
+  sf::Vector2f tilePos = getTilePosition(slot);
+  sf::RectangleShape erase({static_cast<float>(IMPOSTOR_SIZE),
+                            static_cast<float>(IMPOSTOR_SIZE)});
+  erase.setPosition(tilePos);
+  erase.setFillColor(sf::Color::Transparent);
+  page.target->draw(erase, sf::RenderStates(sf::BlendNone));
+
+  sf::RenderStates states;
+  states.transform.translate(tilePos);
+  states.transform.scale({IMPOSTOR_SIZE / CHUNK_PIXELS,
+                          IMPOSTOR_SIZE / CHUNK_PIXELS});
+  bool drawn = chunkCache.drawDownsampled(map, cx, cy, *page.target, states);
+  page.target->display();
+  if (!drawn)
+    return false;
+
+  int32_t chunk = cy * map.getChunksX() + cx;
+  slots[slot].chunk = chunk;
+  slots[slot].lastUsed = useCounter;
+  slotByChunk[chunk] = slot;
+  return true;
+}
+
+bool ChunkImpostorCache::acquireSlot(int32_t &slot) {
+  if (static_cast<int32_t>(slots.size()) < getCapacity()) {
+    slot = static_cast<int32_t>(slots.size());
+    size_t pageIndex = slot / (IMPOSTORS_PER_ROW * IMPOSTORS_PER_ROW);
+    if (pageIndex >= pages.size()) {
+      Page page;
+      page.target = std::make_unique<sf::RenderTexture>();
+      if (!page.target->resize({PAGE_SIZE, PAGE_SIZE})) {
+        std::cerr << "Failed to create impostor page texture" << std::endl;
+        return false;
+      }
+      page.target->setSmooth(true);
+      page.target->clear(sf::Color::Transparent);
+      pages.push_back(std::move(page));
+    }
+    slots.emplace_back();
+    return true;
+  }
+
+  // Evict the least recently used impostor, unless it is on screen
+  auto lru = std::min_element(slots.begin(), slots.end(),
+                              [](const Slot &a, const Slot &b) {
+                                return a.lastUsed < b.lastUsed;
+                              });
+  if (lru->lastUsed == useCounter)
+    return false;
+  slot = static_cast<int32_t>(lru - slots.begin());
+  if (lru->chunk >= 0)
+    slotByChunk[lru->chunk] = SLOT_MISSING;
+  lru->chunk = -1;
+  return true;
+}
+
+void ChunkImpostorCache::appendQuad(int cx, int cy, int32_t slot) {
+  // Quad covering the chunk, sampled half a texel inside the tile so the
+  // smoothing never reads a neighboring impostor
+  Page &page = pages[slot / (IMPOSTORS_PER_ROW * IMPOSTORS_PER_ROW)];
+  sf::Vector2f tilePos = getTilePosition(slot);
+  sf::Vector2f topLeft(cx * CHUNK_PIXELS, cy * CHUNK_PIXELS);
+  sf::Vector2f size(CHUNK_PIXELS, CHUNK_PIXELS);
+  sf::Vector2f uv0 = tilePos + sf::Vector2f(0.5f, 0.5f);
+  sf::Vector2f uv1 = tilePos + sf::Vector2f(IMPOSTOR_SIZE - 0.5f,
+                                            IMPOSTOR_SIZE - 0.5f);
+  auto corner = [&](float u, float v) {
+    return sf::Vertex{{topLeft.x + u * size.x, topLeft.y + v * size.y},
+                      sf::Color::White,
+                      {uv0.x + u * (uv1.x - uv0.x),
+                       uv0.y + v * (uv1.y - uv0.y)}};
+  };
+  page.quads.append(corner(0.f, 0.f));
+  page.quads.append(corner(1.f, 0.f));
+  page.quads.append(corner(0.f, 1.f));
+  page.quads.append(corner(0.f, 1.f));
+  page.quads.append(corner(1.f, 0.f));
+  page.quads.append(corner(1.f, 1.f));
+}
@@ -0,0 +1,131 @@
+#include <Game/World/ChunkTextureCache.hpp>
+#include <Game/World/Map.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+constexpr unsigned CHUNK_PIXELS =
+    static_cast<unsigned>(Map::CHUNK_TILES * Map::TILE_SIZE);
+constexpr size_t BYTES_PER_CHUNK =
+    static_cast<size_t>(CHUNK_PIXELS) * CHUNK_PIXELS * 4;
+} // namespace
+
+void ChunkTextureCache::setBudget(size_t bytes) {
+  budget = bytes;
+  if (entries.size() > getCapacity())
+    clear();
+}
+
+void ChunkTextureCache::clear() {
+  entries.clear();
+  slotByKey.clear();
+}
+
+size_t ChunkTextureCache::getCapacity() const {
+  return std::max<size_t>(1, budget / BYTES_PER_CHUNK);
+}
+
+const sf::Texture *ChunkTextureCache::get(const Map &map, int cx, int cy) {
+  if (!map.hasVisualTiles(cx, cy))
+    return nullptr;
+
+  int key = cy * map.getChunksX() + cx;
+  ++useCounter;
+
+  auto it = slotByKey.find(key);
+  if (it != slotByKey.end()) {
+    Entry &entry = entries[it->second];
+    entry.lastUsed = useCounter;
+    return &entry.target->getTexture();
+  }
+
+  size_t slot;
+  if (!acquireSlot(slot))
+    return nullptr;
+
+  // Flatten the visual layers of the chunk, chunk origin at (0, 0)
+  Entry &entry = entries[slot];
+  sf::RenderStates states;
+  states.transform.translate(
+      {-cx * static_cast<float>(CHUNK_PIXELS),
+       -cy * static_cast<float>(CHUNK_PIXELS)});
+  entry.target->clear(sf::Color::Transparent);
+  map.drawChunk(*entry.target, cx, cy, states, true, false);
+  entry.target->display();
+
+  entry.key = key;
+  entry.lastUsed = useCounter;
+  slotByKey[key] = slot;
+  return &entry.target->getTexture();
+}
+
+bool ChunkTextureCache::drawDownsampled(const Map &map, int cx, int cy,
+                                        sf::RenderTarget &target,
+                                        const sf::RenderStates &states) {
+  if (!get(map, cx, cy))
+    return false;
+
+  // Mipmaps are dropped again by the next display(), and smoothing is only
+  // on while shrinking so regular chunk drawing stays pixel exact
+  sf::RenderTexture &chunkTarget =
+      *entries[slotByKey[cy * map.getChunksX() + cx]].target;
+  if (!chunkTarget.generateMipmap())
+    std::cerr << "Failed to generate chunk mipmaps" << std::endl;
+  chunkTarget.setSmooth(true);
+  sf::RenderStates spriteStates = states;
+  spriteStates.blendMode = BlendPremultiplied;
+  target.draw(sf::Sprite(chunkTarget.getTexture()), spriteStates);
+  chunkTarget.setSmooth(false);
+  return true;
+}
+
+void ChunkTextureCache::prefetch(const Map &map, const sf::FloatRect &area) {
+  float chunkSize = static_cast<float>(CHUNK_PIXELS);
+  int startX = std::max(0, static_cast<int>(area.position.x / chunkSize));
+  int startY = std::max(0, static_cast<int>(area.position.y / chunkSize));
+  int endX = std::min(map.getChunksX() - 1,
+                      static_cast<int>((area.position.x + area.size.x) /
+                                       chunkSize));
+  int endY = std::min(map.getChunksY() - 1,
+                      static_cast<int>((area.position.y + area.size.y) /
+                                       chunkSize));
+
+  int built = 0;
+  for (int cy = startY; cy <= endY; ++cy) {
+    for (int cx = startX; cx <= endX; ++cx) {
+      if (built >= PREFETCH_PER_CALL)
+        return;
+      if (slotByKey.count(cy * map.getChunksX() + cx) ||
+          !map.hasVisualTiles(cx, cy) || map.hasAnimatedTiles(cx, cy))
+        continue;
+      if (get(map, cx, cy))
+        built++;
+    }
+  }
+}
+
+bool ChunkTextureCache::acquireSlot(size_t &slot) {
+  if (entries.size() < getCapacity()) {
+    Entry entry;
+    entry.target = std::make_unique<sf::RenderTexture>();
+    if (!entry.target->resize({CHUNK_PIXELS, CHUNK_PIXELS})) {
+      std::cerr << "Failed to create chunk render texture" << std::endl;
+      return false;
+    }
+    entry.target->setSmooth(false);
+    entries.push_back(std::move(entry));
+    slot = entries.size() - 1;
+    return true;
+  }
+
+  // Evict the least recently used chunk and reuse its texture
+  auto lru = std::min_element(entries.begin(), entries.end(),
+                              [](const Entry &a, const Entry &b) {
+                                return a.lastUsed < b.lastUsed;
+                              });
+  slot = static_cast<size_t>(lru - entries.begin());
+  if (lru->key >= 0)
+    slotByKey.erase(lru->key);
+  lru->key = -1;
+  return true;
+}
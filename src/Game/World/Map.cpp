@@ -1,19 +1,18 @@
+#include <Engine/Graphics/TextGeometry.hpp>
 #include <Game/World/Map.hpp>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 Map::Map() {
   tileShape.setSize({TILE_SIZE, TILE_SIZE});
   tileShape.setFillColor(sf::Color::White);
-
-  // Load font for text objects
-  fontLoaded = font.openFromFile("assets/fonts/font.ttf");
-  if (!fontLoaded) {
-    std::cerr << "Failed to load font for map text" << std::endl;
-  }
 }
 
 bool Map::loadFromFile(const std::string &filename) {
@@ -44,6 +43,8 @@ bool Map::loadFromFile(const std::string &filename) {
   return parseTMX(content, basePath);
 }
 
+const Map::TileProperties Map::defaultTileProperties{};
+
 // Helper function to extract attribute value from XML tag
 std::string extractAttribute(const std::string &tag,
                              const std::string &attrName) {
@@ -58,6 +59,62 @@ std::string extractAttribute(const std::string &tag,
   return tag.substr(start, end - start);
 }
 
+// Calls visit(name, value) for every <property> tag in an XML block
+template <typename Visitor>
+void forEachProperty(const std::string &block, Visitor &&visit) {
+  size_t pos = 0;
+  while ((pos = block.find("<property ", pos)) != std::string::npos) {
+    size_t tagEnd = block.find(">", pos);
+    if (tagEnd == std::string::npos)
+      break;
+    std::string tag = block.substr(pos, tagEnd - pos);
+    visit(extractAttribute(tag, "name"), extractAttribute(tag, "value"));
+    pos = tagEnd;
+  }
+}
+
+// Reads the <frame tileid=".." duration=".."/> tags of a tile's <animation>
+std::vector<Map::AnimationFrame>
+parseAnimationFrames(const std::string &block) {
+  std::vector<Map::AnimationFrame> frames;
+  size_t pos = block.find("<animation");
+  while (pos != std::string::npos &&
+         (pos = block.find("<frame ", pos)) != std::string::npos) {
+    size_t tagEnd = block.find(">", pos);
+    if (tagEnd == std::string::npos)
+      break;
+    std::string tag = block.substr(pos, tagEnd - pos);
+    Map::AnimationFrame frame;
+    frame.localId = std::atoi(extractAttribute(tag, "tileid").c_str());
+    frame.duration =
+        std::max(1, std::atoi(extractAttribute(tag, "duration").c_str()));
+    frames.push_back(frame);
+    pos = tagEnd;
+  }
+  return frames;
+}
+
+// Maps a Tiled tile type/class name to its collision flag (0 if unknown)
+uint8_t collisionFlagFromType(const std::string &type) {
+  if (type == "wall")
+    return Map::CollisionWall;
+  if (type == "platform")
+    return Map::CollisionPlatform;
+  if (type == "spikes")
+    return Map::CollisionSpikes;
+  if (type == "finish")
+    return Map::CollisionFinish;
+  if (type == "start")
+    return Map::CollisionStart;
+  return 0;
+}
+
+// Collision of each column of the legacy gameplay tileset, which predates
+// tile types (heart, star, red block, platform, spikes)
+constexpr uint8_t LEGACY_COLUMN_FLAGS[] = {
+    Map::CollisionStart, Map::CollisionFinish, Map::CollisionWall,
+    Map::CollisionPlatform, Map::CollisionSpikes};
+
 bool Map::parseTMX(const std::string &content, const std::string &basePath) {
   layers.clear();
   textObjects.clear();
@@ -71,6 +128,8 @@ bool Map::parseTMX(const std::string &content, const std::string &basePath) {
 
   int mapWidth = std::stoi(extractAttribute(mapTag, "width"));
   int mapHeight = std::stoi(extractAttribute(mapTag, "height"));
+  widthInTiles = mapWidth;
+  heightInTiles = mapHeight;
 
   // Parse all <tileset> tags
   size_t pos = 0;
@@ -136,11 +195,13 @@ bool Map::parseTMX(const std::string &content, const std::string &basePath) {
                                        : rawSource.substr(lastSlash + 1);
             ts.imageSource = "assets/tilesets/" + filename;
 
-            if (!ts.texture.loadFromFile(ts.imageSource)) {
+            if (!loadTilesetImage(ts)) {
               std::cerr << "Failed to load external tileset image: "
                         << ts.imageSource << std::endl;
             }
           }
+
+          parseTileProperties(tsxContent, ts);
         }
       } else {
         std::cerr << "Failed to open external tileset file: " << tsxPath
@@ -182,17 +243,21 @@ bool Map::parseTMX(const std::string &content, const std::string &basePath) {
                                    : rawSource.substr(lastSlash + 1);
         ts.imageSource = "assets/tilesets/" + filename;
 
-        if (!ts.texture.loadFromFile(ts.imageSource)) {
+        if (!loadTilesetImage(ts)) {
           std::cerr << "Failed to load tileset image: " << ts.imageSource
                     << std::endl;
         }
       }
 
+      parseTileProperties(tilesetContent, ts);
+
       tilesets.push_back(std::move(ts));
       pos = tilesetEnd + 10;
     }
   }
 
+  buildTileLookup();
+
   // Parse layers
   pos = 0;
   while (true) {
@@ -213,140 +278,272 @@ bool Map::parseTMX(const std::string &content, const std::string &basePath) {
           dataStart + 21,
           dataEnd - (dataStart + 21)); // 21 = length of opening tag
 
-      auto grid = parseLayerData(csvData, mapWidth, mapHeight);
-      layers.push_back({layerName, grid});
+      Layer layer;
+      layer.name = layerName;
+      layer.width = mapWidth;
+      layer.height = mapHeight;
+      parseLayerData(csvData, layer);
+      layers.push_back(std::move(layer));
     }
 
     pos = dataEnd + 7; // Move past </data>
   }
 
-  // Find spawn and finish in all layers
+  // Classify gameplay tiles once so queries never touch tilesets
+  buildCollisionLayer();
+  buildColliders();
+  buildBitboards();
+  buildChunks();
+  chunkCache.clear();
+  chunkImpostors.clear();
+
+  // Parse object groups (for text)
+  parseObjectGroup(content);
+
+  // Bake text hint geometry
+  buildTextHints();
+
+  std::cout << "Loaded TMX map: " << mapWidth << "x" << mapHeight << " tiles"
+            << std::endl;
+  std::cout << "Text objects found: " << textObjects.size() << std::endl;
+  std::cout << "Merged colliders: " << colliders.size() << std::endl;
+  std::cout << "Occluded tiles: " << occludedTiles << std::endl;
+  std::cout << "Animated tiles: " << animatedTiles.size() << std::endl;
+  if (hasSpillingTiles()) {
+    std::cerr << "Warning: tiles larger than " << TILE_SIZE
+              << "px cross chunk edges; drawing layer by layer without "
+                 "chunk caching or impostors"
+              << std::endl;
+    setChunkCaching(false);
+  }
+
+  return !layers.empty();
+}
+
+void Map::buildCollisionLayer() {
+  collisionGrid.assign(static_cast<size_t>(widthInTiles) * heightInTiles, 0);
+  collisionTiles.assign(collisionGrid.size(), 0);
+
   int spawnCount = 0;
   for (const auto &layer : layers) {
-    for (size_t y = 0; y < layer.grid.size(); ++y) {
-      for (size_t x = 0; x < layer.grid[y].size(); ++x) {
-        uint32_t rawId = layer.grid[y][x];
-        if (rawId == 0)
+    for (int y = 0; y < layer.height; ++y) {
+      for (int x = 0; x < layer.width; ++x) {
+        int id = layer.tileAt(x, y);
+        if (id == 0)
           continue;
 
-        int id = static_cast<int>(rawId & TILE_MASK);
-        const TilesetInfo *ts = getTilesetForId(id);
-        if (!ts)
+        const TileProperties &props = getTileProperties(id);
+        if (!props.collision)
           continue;
 
-        if (ts->name == "ts_main" || ts->name == "MainTileset") {
-          int type = (id - ts->firstgid) % ts->columns;
-          if (type == TileType::Start) {
-            if (spawnCount > 0) {
-              std::cerr << "Warning: Multiple spawn points found!" << std::endl;
-            }
-            startPosition = {
-                static_cast<float>(x) * TILE_SIZE + TILE_SIZE / 2.f,
-                static_cast<float>(y) * TILE_SIZE + TILE_SIZE / 2.f};
-            spawnCount++;
-          } else if (type == TileType::Finish) {
-            bool flipH = (rawId & FLIP_H);
-            bool flipV = (rawId & FLIP_V);
-            bool flipD = (rawId & FLIP_D);
-
-            float rot = 0.f;
-            if (!flipD && !flipH && !flipV) {
-              rot = 0.f;
-            } else if (flipD && flipH && !flipV) {
-              rot = 90.f;
-            } else if (!flipD && flipH && flipV) {
-              rot = 180.f;
-            } else if (flipD && !flipH && flipV) {
-              rot = 270.f;
-            }
-            // Consider mirrored cases, but standard rotations are these 4.
-            else if (flipH) {
-              rot = 0.f;
-            } // H flip only
-            else if (flipV) {
-              rot = 180.f;
-            } // V flip only
-
-            sf::FloatRect trigger;
-            if (rot == 0.f) {
-              trigger = sf::FloatRect({static_cast<float>(x) * TILE_SIZE,
-                                       static_cast<float>(y) * TILE_SIZE},
-                                      {TILE_SIZE, 1.f});
-            } else if (rot == 90.f) {
-              trigger = sf::FloatRect(
-                  {static_cast<float>(x) * TILE_SIZE + TILE_SIZE - 1.f,
-                   static_cast<float>(y) * TILE_SIZE},
-                  {1.f, TILE_SIZE});
-            } else if (rot == 180.f) {
-              trigger = sf::FloatRect(
-                  {static_cast<float>(x) * TILE_SIZE,
-                   static_cast<float>(y) * TILE_SIZE + TILE_SIZE - 1.f},
-                  {TILE_SIZE, 1.f});
-            } else if (rot == 270.f) {
-              trigger = sf::FloatRect({static_cast<float>(x) * TILE_SIZE,
-                                       static_cast<float>(y) * TILE_SIZE},
-                                      {1.f, TILE_SIZE});
-            } else {
-              trigger = sf::FloatRect({static_cast<float>(x) * TILE_SIZE,
-                                       static_cast<float>(y) * TILE_SIZE},
-                                      {TILE_SIZE, 1.f});
-            }
+        // Upper layers override the material of the cell
+        size_t index = static_cast<size_t>(y) * widthInTiles + x;
+        collisionGrid[index] |= props.collision;
+        collisionTiles[index] = static_cast<uint16_t>(id);
 
-            finishAreas.push_back(trigger);
+        if (props.collision & CollisionStart) {
+          if (spawnCount > 0) {
+            std::cerr << "Warning: Multiple spawn points found!" << std::endl;
           }
+          startPosition = {static_cast<float>(x) * TILE_SIZE + TILE_SIZE / 2.f,
+                           static_cast<float>(y) * TILE_SIZE + TILE_SIZE / 2.f};
+          spawnCount++;
+        }
+
+        if (props.collision & CollisionFinish) {
+          uint8_t flags = layer.flipsAt(x, y);
+          bool flipH = (flags & CELL_FLIP_H);
+          bool flipV = (flags & CELL_FLIP_V);
+          bool flipD = (flags & CELL_FLIP_D);
+
+          float rot = 0.f;
+          if (!flipD && !flipH && !flipV) {
+            rot = 0.f;
+          } else if (flipD && flipH && !flipV) {
+            rot = 90.f;
+          } else if (!flipD && flipH && flipV) {
+            rot = 180.f;
+          } else if (flipD && !flipH && flipV) {
+            rot = 270.f;
+          }
+          // Consider mirrored cases, but standard rotations are these 4.
+          else if (flipH) {
+            rot = 0.f;
+          } // H flip only
+          else if (flipV) {
+            rot = 180.f;
+          } // V flip only
+
+          sf::FloatRect trigger;
+          if (rot == 0.f) {
+            trigger = sf::FloatRect({static_cast<float>(x) * TILE_SIZE,
+                                     static_cast<float>(y) * TILE_SIZE},
+                                    {TILE_SIZE, 1.f});
+          } else if (rot == 90.f) {
+            trigger = sf::FloatRect(
+                {static_cast<float>(x) * TILE_SIZE + TILE_SIZE - 1.f,
+                 static_cast<float>(y) * TILE_SIZE},
+                {1.f, TILE_SIZE});
+          } else if (rot == 180.f) {
+            trigger = sf::FloatRect(
+                {static_cast<float>(x) * TILE_SIZE,
+                 static_cast<float>(y) * TILE_SIZE + TILE_SIZE - 1.f},
+                {TILE_SIZE, 1.f});
+          } else if (rot == 270.f) {
+            trigger = sf::FloatRect({static_cast<float>(x) * TILE_SIZE,
+                                     static_cast<float>(y) * TILE_SIZE},
+                                    {1.f, TILE_SIZE});
+          } else {
+            trigger = sf::FloatRect({static_cast<float>(x) * TILE_SIZE,
+                                     static_cast<float>(y) * TILE_SIZE},
+                                    {TILE_SIZE, 1.f});
+          }
+
+          finishAreas.push_back(trigger);
         }
       }
     }
   }
+}
 
-  // Parse object groups (for text)
-  parseObjectGroup(content);
+void Map::buildColliders() {
+  colliders.clear();
+
+  // Grow each free cell into the widest run, then (for walls) extend the run
+  // downwards while the full row below matches. Platforms only merge
+  // horizontally so every platform row keeps its own landing surface.
+  auto mergeCells = [this](uint8_t kind, bool growDown) {
+    std::vector<uint8_t> used(collisionGrid.size(), 0);
+    auto isFree = [&](int x, int y) {
+      size_t i = static_cast<size_t>(y) * widthInTiles + x;
+      return (collisionGrid[i] & kind) && !used[i];
+    };
+
+    for (int y = 0; y < heightInTiles; ++y) {
+      for (int x = 0; x < widthInTiles; ++x) {
+        if (!isFree(x, y))
+          continue;
 
-  // Prepare cached text objects
-  prepareTextObjects();
+        int right = x;
+        while (right + 1 < widthInTiles && isFree(right + 1, y))
+          ++right;
+
+        int bottom = y;
+        while (growDown && bottom + 1 < heightInTiles) {
+          bool rowMatches = true;
+          for (int cx = x; cx <= right && rowMatches; ++cx)
+            rowMatches = isFree(cx, bottom + 1);
+          if (!rowMatches)
+            break;
+          ++bottom;
+        }
 
-  std::cout << "Loaded TMX map: " << mapWidth << "x" << mapHeight << " tiles"
-            << std::endl;
-  std::cout << "Text objects found: " << textObjects.size() << std::endl;
+        for (int cy = y; cy <= bottom; ++cy)
+          for (int cx = x; cx <= right; ++cx)
+            used[static_cast<size_t>(cy) * widthInTiles + cx] = 1;
 
-  return !layers.empty();
+        colliders.push_back({x, y, right, bottom, kind});
+      }
+    }
+  };
+
+  mergeCells(CollisionWall, true);
+  mergeCells(CollisionPlatform, false);
+
+  // Bucket index: each collider is listed in every bucket it overlaps
+  const int B = COLLIDER_BUCKET_TILES;
+  colliderBucketsX = (widthInTiles + B - 1) / B;
+  colliderBucketsY = (heightInTiles + B - 1) / B;
+  colliderBucketStart.assign(
+      static_cast<size_t>(colliderBucketsX) * colliderBucketsY + 1, 0);
+
+  for (const auto &c : colliders)
+    for (int by = c.top / B; by <= c.bottom / B; ++by)
+      for (int bx = c.left / B; bx <= c.right / B; ++bx)
+        colliderBucketStart[by * colliderBucketsX + bx + 1]++;
+
+  for (size_t i = 1; i < colliderBucketStart.size(); ++i)
+    colliderBucketStart[i] += colliderBucketStart[i - 1];
+
+  colliderBucketItems.resize(colliderBucketStart.back());
+  std::vector<uint32_t> cursor(colliderBucketStart.begin(),
+                               colliderBucketStart.end() - 1);
+  for (uint32_t index = 0; index < colliders.size(); ++index) {
+    const Collider &c = colliders[index];
+    for (int by = c.top / B; by <= c.bottom / B; ++by)
+      for (int bx = c.left / B; bx <= c.right / B; ++bx)
+        colliderBucketItems[cursor[by * colliderBucketsX + bx]++] = index;
+  }
 }
 
-std::vector<std::vector<uint32_t>>
-Map::parseLayerData(const std::string &csvData, int width, int height) {
-  std::vector<std::vector<uint32_t>> grid;
-  std::stringstream ss(csvData);
-  std::string line;
-
-  while (std::getline(ss, line)) {
-    // Skip empty lines
-    if (line.empty() || line.find_first_not_of(" \t\r\n") == std::string::npos)
-      continue;
+void Map::buildBitboards() {
+  bitboardWords = (widthInTiles + 63) / 64;
+  size_t wordCount = static_cast<size_t>(bitboardWords) * heightInTiles;
+  solidBits.assign(wordCount, 0);
+  platformBits.assign(wordCount, 0);
+  hazardBits.assign(wordCount, 0);
+
+  for (int y = 0; y < heightInTiles; ++y) {
+    for (int x = 0; x < widthInTiles; ++x) {
+      uint8_t cell = collisionGrid[y * widthInTiles + x];
+      if (cell == 0)
+        continue;
+
+      size_t word = static_cast<size_t>(y) * bitboardWords + (x >> 6);
+      uint64_t bit = uint64_t{1} << (x & 63);
+      if (cell & CollisionWall)
+        solidBits[word] |= bit;
+      if (cell & CollisionPlatform)
+        platformBits[word] |= bit;
+      if (cell & CollisionSpikes)
+        hazardBits[word] |= bit;
+    }
+  }
+}
 
-    std::vector<uint32_t> row;
-    std::stringstream lineStream(line);
-    std::string cell;
-
-    while (std::getline(lineStream, cell, ',')) {
-      // Remove whitespace
-      cell.erase(std::remove_if(cell.begin(), cell.end(), ::isspace),
-                 cell.end());
-      if (!cell.empty()) {
-        try {
-          uint32_t rawId = std::stoul(cell);
-          row.push_back(rawId);
-        } catch (...) {
-          row.push_back(0);
-        }
+void Map::parseLayerData(const std::string &csvData, Layer &layer) {
+  size_t cellCount = static_cast<size_t>(layer.width) * layer.height;
+  layer.tiles.assign(cellCount, 0);
+  layer.flips.assign(cellCount, 0);
+
+  // Values are read sequentially into the row-major buffer; line breaks in
+  // the CSV are just whitespace.
+  size_t index = 0;
+  uint32_t value = 0;
+  bool hasDigits = false;
+
+  auto storeValue = [&]() {
+    if (hasDigits && index < cellCount) {
+      uint32_t id = value & TILE_MASK;
+      if (id > UINT16_MAX) {
+        std::cerr << "Warning: tile ID " << id << " in layer '" << layer.name
+                  << "' exceeds 16 bits, ignoring" << std::endl;
+        id = 0;
       }
+      layer.tiles[index] = static_cast<uint16_t>(id);
+      layer.flips[index] =
+          id ? static_cast<uint8_t>(value >> FLIP_SHIFT) : uint8_t{0};
     }
-
-    if (!row.empty()) {
-      grid.push_back(row);
+    if (hasDigits)
+      ++index;
+    value = 0;
+    hasDigits = false;
+  };
+
+  for (char c : csvData) {
+    if (c >= '0' && c <= '9') {
+      value = value * 10 + static_cast<uint32_t>(c - '0');
+      hasDigits = true;
+    } else if (c == ',') {
+      storeValue();
     }
   }
+  storeValue();
 
-  return grid;
+  if (index != cellCount) {
+    std::cerr << "Warning: layer '" << layer.name << "' has " << index
+              << " tiles, expected " << cellCount << std::endl;
+  }
 }
 
 void Map::parseObjectGroup(const std::string &content) {
@@ -428,223 +625,128 @@ void Map::parseObjectGroup(const std::string &content) {
   }
 }
 
-void Map::render(sf::RenderWindow &window, sf::Vector2f playerPos,
-                 bool showHitboxes) {
+void Map::render(sf::RenderTarget &window, TextHintView &hints,
+                 sf::Vector2f playerPos, bool showHitboxes) {
   // Get the current view bounds for culling
   sf::View view = window.getView();
   sf::Vector2f viewCenter = view.getCenter();
   sf::Vector2f viewSize = view.getSize();
 
-  // Calculate visible tile range (with 1 tile margin for safety)
-  // Use first layer for bounds since all layers should have same dimensions
-  int gridHeight = layers.empty() ? 0 : static_cast<int>(layers[0].grid.size());
-  int gridWidth =
-      gridHeight > 0 ? static_cast<int>(layers[0].grid[0].size()) : 0;
-
-  int startX = std::max(
-      0, static_cast<int>((viewCenter.x - viewSize.x / 2.f) / TILE_SIZE) - 1);
-  int startY = std::max(
-      0, static_cast<int>((viewCenter.y - viewSize.y / 2.f) / TILE_SIZE) - 1);
-  int endX = std::min(
-      gridWidth,
-      static_cast<int>((viewCenter.x + viewSize.x / 2.f) / TILE_SIZE) + 2);
-  int endY = std::min(
-      gridHeight,
-      static_cast<int>((viewCenter.y + viewSize.y / 2.f) / TILE_SIZE) + 2);
-
-  // Render all layers (back to front)
-  for (const auto &layer : layers) {
-    const auto &grid = layer.grid;
-    if (grid.empty())
-      continue;
-
-    for (int y = startY; y < endY; ++y) {
-      for (int x = startX; x < endX; ++x) {
-        if (y >= 0 && y < static_cast<int>(grid.size()) && x >= 0 &&
-            x < static_cast<int>(grid[y].size())) {
-          uint32_t rawId = grid[y][x];
-
-          // Skip empty tiles
-          if (rawId == 0)
-            continue;
-
-          // Extract flip flags
-          bool flipH = (rawId & FLIP_H);
-          bool flipV = (rawId & FLIP_V);
-          bool flipD = (rawId & FLIP_D);
-
-          // Get actual tile ID (mask out any flip flags)
-          int tileId = static_cast<int>(rawId & TILE_MASK);
-
-          const TilesetInfo *ts = getTilesetForId(tileId);
-          if (!ts)
-            continue;
-
-          // ts_main (collision block) should only render if showHitboxes is
-          // true.
-          if (ts->name == "ts_main" || ts->name == "MainTileset") {
-            if (!showHitboxes)
-              continue;
-          }
-
-          // Texture Rect logic based on this specific tileset
-          int localId = tileId - ts->firstgid;
-          int tileCol = localId % ts->columns;
-          int tileRow = localId / ts->columns;
-
-          // Calculate texture rect from tileset position
-          int texX = tileCol * ts->tilewidth;
-          int texY = tileRow * ts->tileheight;
-
-          sf::Sprite tileSprite(ts->texture);
-          tileSprite.setTextureRect(
-              sf::IntRect({texX, texY}, {ts->tilewidth, ts->tileheight}));
-
-          // Rotation and Flip Logic (Tiled to SFML mapping)
-          float rot = 0.f;
-          float sx = 1.f;
-          float sy = 1.f;
-
-          if (!flipD && !flipH && !flipV) {
-            rot = 0.f;
-          } else if (!flipD && flipH && !flipV) {
-            sx = -1.f;
-          } else if (!flipD && !flipH && flipV) {
-            sy = -1.f;
-          } else if (!flipD && flipH && flipV) {
-            rot = 180.f;
-          } else if (flipD && !flipH && !flipV) {
-            rot = 270.f;
-            sx = -1.f;
-          } else if (flipD && flipH && !flipV) {
-            rot = 90.f;
-          } else if (flipD && !flipH && flipV) {
-            rot = 270.f;
-          } else if (flipD && flipH && flipV) {
-            rot = 90.f;
-            sx = -1.f;
-          }
-
-          // Use center origin so rotation and scaling behave independently
-          tileSprite.setOrigin({TILE_SIZE / 2.f, TILE_SIZE / 2.f});
-          tileSprite.setScale({sx, sy});
-          tileSprite.setRotation(sf::degrees(rot));
-
-          // Position must shift by half a tile to compensate for center origin
-          tileSprite.setPosition(
-              {static_cast<float>(x) * TILE_SIZE + TILE_SIZE / 2.f,
-               static_cast<float>(y) * TILE_SIZE + TILE_SIZE / 2.f});
-
-          window.draw(tileSprite);
+  // Calculate visible tile range (with 1 tile margin for safety, plus the
+  // reach of tiles larger than a cell)
+  int gridWidth = widthInTiles;
+  int gridHeight = heightInTiles;
+  int margin = 1 + (tileSpill + static_cast<int>(TILE_SIZE) - 1) /
+                       static_cast<int>(TILE_SIZE);
+
+  sf::Vector2f viewMin = (viewCenter - viewSize / 2.f) / TILE_SIZE;
+  sf::Vector2f viewMax = (viewCenter + viewSize / 2.f) / TILE_SIZE;
+
+  int startX = std::max(0, static_cast<int>(viewMin.x) - margin);
+  int startY = std::max(0, static_cast<int>(viewMin.y) - margin);
+  int endX = std::min(gridWidth, static_cast<int>(viewMax.x) + margin + 1);
+  int endY = std::min(gridHeight, static_cast<int>(viewMax.y) + margin + 1);
+
+  // Visible chunk range
+  int chunkStartX = startX / CHUNK_TILES;
+  int chunkStartY = startY / CHUNK_TILES;
+  int chunkEndX = (endX + CHUNK_TILES - 1) / CHUNK_TILES;
+  int chunkEndY = (endY + CHUNK_TILES - 1) / CHUNK_TILES;
+
+  // Far zoomed out, draw the visible area from impostors. They are shrunk
+  // from chunk-clipped textures, which would cut spilling tiles, so maps
+  // with those always take the layer-by-layer path.
+  float screenWidth = window.getSize().x * view.getViewport().size.x;
+  if (!hasSpillingTiles() && screenWidth > 0.f &&
+      viewSize.x / screenWidth >= LOD_SCALE) {
+    chunkImpostors.render(window, *this, chunkCache,
+                          {chunkStartX, chunkStartY}, {chunkEndX, chunkEndY});
+  } else if (hasSpillingTiles()) {
+    // Large tiles reach into neighboring chunks, so draw one layer of every
+    // visible chunk at a time to keep the layer order across chunk edges
+    for (int li = 0; li < static_cast<int>(layers.size()); ++li)
+      for (int cy = chunkStartY; cy < chunkEndY; ++cy)
+        for (int cx = chunkStartX; cx < chunkEndX; ++cx)
+          drawChunk(window, cx, cy, sf::RenderStates::Default, true,
+                    showHitboxes, li);
+  } else {
+    // Render visible chunks. Every tile stays inside its cell, so chunks
+    // never overlap and drawing all layers of one chunk before the next keeps
+    // the layer order.
+    for (int cy = chunkStartY; cy < chunkEndY; ++cy) {
+      for (int cx = chunkStartX; cx < chunkEndX; ++cx) {
+        // Animated chunks change every few frames, so they are always drawn
+        // from their vertices
+        const sf::Texture *cached =
+            chunkCaching && !hasAnimatedTiles(cx, cy)
+                ? chunkCache.get(*this, cx, cy)
+                : nullptr;
+        if (cached) {
+          sf::Sprite chunkSprite(*cached);
+          chunkSprite.setPosition({cx * CHUNK_TILES * TILE_SIZE,
+                                   cy * CHUNK_TILES * TILE_SIZE});
+          window.draw(chunkSprite, ChunkTextureCache::BlendPremultiplied);
         }
+
+        // Gameplay tilesets (ts_main) only render if showHitboxes is true
+        drawChunk(window, cx, cy, sf::RenderStates::Default, !cached,
+                  showHitboxes);
       }
     }
   }
 
-  // Render cached text objects (no allocation in render loop)
-  for (auto &text : cachedTexts) {
-    // Proximity Fade Logic
-    sf::Vector2f textPos = text.getPosition();
-    sf::Vector2f textSize = text.getGlobalBounds().size;
-
-    // Estimate text center for distance
-    sf::Vector2f textCenter = {textPos.x + textSize.x / 2.f,
-                               textPos.y + textSize.y / 2.f};
-
-    // Calculate squared distance to player (avoid sqrt if possible, but for
-    // linear fade we need sqrt)
-    float dx = textCenter.x - playerPos.x;
-    float dy = textCenter.y - playerPos.y;
-    float distSq = dx * dx + dy * dy;
-    float dist = std::sqrt(distSq);
-
-    // Fade parameters (pixels)
-    float fadeStartDist = 75.f; // Fully visible within this range
-    float fadeEndDist = 150.f;  // Fully invisible outside this range
-
-    float alpha = 0.f;
-    if (dist < fadeStartDist) {
-      alpha = 255.f;
-    } else if (dist < fadeEndDist) {
-      // Linearly interpolate
-      float t = (dist - fadeStartDist) / (fadeEndDist - fadeStartDist);
-      alpha = 255.f * (1.f - t);
-    }
-
-    // SFML 3.x uses u8 for Color constructor
-    sf::Color color = text.getFillColor();
-    color.a = static_cast<uint8_t>(alpha);
-    text.setFillColor(color);
-
-    sf::Color outline = text.getOutlineColor();
-    outline.a = static_cast<uint8_t>(alpha);
-    text.setOutlineColor(outline);
+  // Text hints near the player, one draw call for all of them
+  renderTextHints(window, hints,
+                  sf::FloatRect(viewCenter - viewSize / 2.f, viewSize),
+                  playerPos);
+}
 
-    if (alpha > 0) {
-      window.draw(text);
-    }
-  }
+void Map::drawDebug(DebugDraw &debug, const sf::FloatRect &area) const {
+  int left, top, right, bottom;
+  if (!getTileRange(area, left, top, right, bottom))
+    return;
 
-  // Draw hitboxes for debugging if enabled
-  if (showHitboxes) {
-    sf::RectangleShape hazardShape;
-    hazardShape.setFillColor(
-        sf::Color(128, 0, 128, 100)); // Semi-transparent purple
-    hazardShape.setOutlineColor(sf::Color(128, 0, 128));
-    hazardShape.setOutlineThickness(1.f);
-
-    for (const auto &layer : layers) {
-      for (int y = startY; y < endY; ++y) {
-        for (int x = startX; x < endX; ++x) {
-          if (y >= 0 && y < static_cast<int>(layer.grid.size()) && x >= 0 &&
-              x < static_cast<int>(layer.grid[y].size())) {
-            int id = layer.grid[y][x] & TILE_MASK;
-            if (id > 0) {
-              const TilesetInfo *ts = getTilesetForId(id);
-              if (!ts)
-                continue;
-
-              int localId = id - ts->firstgid;
-              int functionalId = localId % ts->columns;
-
-              if ((ts->name == "ts_main" || ts->name == "MainTileset") &&
-                  functionalId == TileType::Spikes) {
-                sf::FloatRect bounds({x * TILE_SIZE, y * TILE_SIZE},
-                                     {TILE_SIZE, TILE_SIZE});
-                bounds.position.x += 4.f;
-                bounds.size.x -= 8.f;
-                bounds.position.y += 10.f;
-                bounds.size.y -= 10.f;
-
-                hazardShape.setPosition(bounds.position);
-                hazardShape.setSize(bounds.size);
-                window.draw(hazardShape);
-              }
-            }
-          }
-        }
+  // Merged wall and platform colliders
+  forEachCollider(left, top, right, bottom,
+                  CollisionWall | CollisionPlatform, [&](const Collider &c) {
+                    sf::Color color = (c.flags & CollisionWall)
+                                          ? sf::Color(255, 64, 64)
+                                          : sf::Color(64, 160, 255);
+                    debug.rect(c.getBounds(), sf::Color::Transparent, color);
+                  });
+
+  // Spike hitboxes, found through the hazard bitboard
+  for (int y = top; y <= bottom; ++y) {
+    const uint64_t *row = &hazardBits[static_cast<size_t>(y) * bitboardWords];
+    for (int w = left >> 6; w <= right >> 6; ++w) {
+      for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+        int x = (w << 6) + std::countr_zero(bits);
+        if (x < left || x > right)
+          continue;
+        debug.rect(getSpikeBounds(x, y), sf::Color(128, 0, 128, 100),
+                   sf::Color(128, 0, 128));
       }
     }
   }
 }
 
-// Prepare text objects once (called after map loading)
-void Map::prepareTextObjects() {
-  cachedTexts.clear();
+// Bake text objects into glyph quads once (called after map loading)
+void Map::buildTextHints() {
+  textHints.clear();
+  textHintVertices.clear();
+  textHintBucketStart.clear();
+  textHintBucketItems.clear();
+  ++textHintGeneration;
 
-  if (!fontLoaded)
+  if (!font)
     return;
 
-  // Reserve space to avoid reallocations
-  cachedTexts.reserve(textObjects.size());
+  // Only used to measure lines for word wrapping
+  sf::Text text(*font);
+  text.setCharacterSize(HINT_CHARACTER_SIZE);
+  text.setOutlineThickness(HINT_OUTLINE);
 
   for (const auto &textObj : textObjects) {
-    sf::Text text(font);
-    text.setCharacterSize(12);
-    text.setFillColor(sf::Color::White);
-    text.setOutlineColor(sf::Color::Black);
-    text.setOutlineThickness(1.f);
-
     // Manual word wrap based on object width from Tiled
     std::string wrappedText;
     std::string currentLine;
@@ -687,61 +789,228 @@ void Map::prepareTextObjects() {
       wrappedText += currentLine;
     }
 
-    text.setString(wrappedText);
-    text.setPosition(textObj.position);
-    cachedTexts.push_back(std::move(text));
+    // Glyph quads, outline first (faded in and out, so alpha starts at 0)
+    TextHint hint;
+    hint.firstVertex = static_cast<uint32_t>(textHintVertices.size());
+    hint.bounds = appendText(textHintVertices, *font, wrappedText,
+                             HINT_CHARACTER_SIZE, textObj.position,
+                             sf::Color(255, 255, 255, 0), HINT_OUTLINE,
+                             sf::Color(0, 0, 0, 0));
+    hint.vertexCount =
+        static_cast<uint32_t>(textHintVertices.size()) - hint.firstVertex;
+    if (hint.vertexCount == 0)
+      continue;
+    textHints.push_back(hint);
   }
-}
 
-std::vector<sf::FloatRect>
-Map::checkCollision(const sf::FloatRect &bounds) const {
-  std::vector<sf::FloatRect> collisions;
+  // Bucket the hints on a uniform grid (CSR layout, like the colliders)
+  const float cell = HINT_BUCKET_SIZE;
+  textHintBucketsX =
+      std::max(1, static_cast<int>(std::ceil(getWidth() / cell)));
+  textHintBucketsY =
+      std::max(1, static_cast<int>(std::ceil(getHeight() / cell)));
+  auto bucketRange = [&](const sf::FloatRect &b, int &l, int &t, int &r,
+                         int &bt) {
+    l = std::clamp(static_cast<int>(b.position.x / cell), 0,
+                   textHintBucketsX - 1);
+    t = std::clamp(static_cast<int>(b.position.y / cell), 0,
+                   textHintBucketsY - 1);
+    r = std::clamp(static_cast<int>((b.position.x + b.size.x) / cell), 0,
+                   textHintBucketsX - 1);
+    bt = std::clamp(static_cast<int>((b.position.y + b.size.y) / cell), 0,
+                    textHintBucketsY - 1);
+  };
+
+  textHintBucketStart.assign(
+      static_cast<size_t>(textHintBucketsX) * textHintBucketsY + 1, 0);
+  for (const auto &hint : textHints) {
+    int l, t, r, bt;
+    bucketRange(hint.bounds, l, t, r, bt);
+    for (int by = t; by <= bt; ++by)
+      for (int bx = l; bx <= r; ++bx)
+        textHintBucketStart[by * textHintBucketsX + bx + 1]++;
+  }
+  for (size_t i = 1; i < textHintBucketStart.size(); ++i)
+    textHintBucketStart[i] += textHintBucketStart[i - 1];
+
+  textHintBucketItems.resize(textHintBucketStart.back());
+  std::vector<uint32_t> fill(textHintBucketStart.begin(),
+                             textHintBucketStart.end() - 1);
+  for (uint32_t i = 0; i < textHints.size(); ++i) {
+    int l, t, r, bt;
+    bucketRange(textHints[i].bounds, l, t, r, bt);
+    for (int by = t; by <= bt; ++by)
+      for (int bx = l; bx <= r; ++bx)
+        textHintBucketItems[fill[by * textHintBucketsX + bx]++] = i;
+  }
+}
 
-  // Calculate tile range to check
-  int left_tile = static_cast<int>(bounds.position.x / TILE_SIZE);
-  int top_tile = static_cast<int>(bounds.position.y / TILE_SIZE);
-  int right_tile =
-      static_cast<int>((bounds.position.x + bounds.size.x) / TILE_SIZE);
-  int bottom_tile =
-      static_cast<int>((bounds.position.y + bounds.size.y) / TILE_SIZE);
+void Map::renderTextHints(sf::RenderTarget &target, TextHintView &hints,
+                          const sf::FloatRect &view, sf::Vector2f playerPos) {
+  // Indices from an earlier map no longer match
+  bool dirty = hints.generation != textHintGeneration;
+  if (dirty) {
+    hints.visible.clear();
+    hints.alphas.clear();
+    hints.batch.clear();
+    hints.generation = textHintGeneration;
+  }
+  if (textHints.empty())
+    return;
 
-  // Clamp to map bounds
-  if (left_tile < 0)
-    left_tile = 0;
-  if (top_tile < 0)
-    top_tile = 0;
-  if (layers.empty() || layers[0].grid.empty())
-    return collisions;
-  if (right_tile >= static_cast<int>(layers[0].grid[0].size()))
-    right_tile = static_cast<int>(layers[0].grid[0].size()) - 1;
-  if (bottom_tile >= static_cast<int>(layers[0].grid.size()))
-    bottom_tile = static_cast<int>(layers[0].grid.size()) - 1;
+  // Hints are only visible within HINT_FADE_END of the player, so only the
+  // buckets around the player are looked at
+  const float cell = HINT_BUCKET_SIZE;
+  int left = std::max(
+      0, static_cast<int>((playerPos.x - HINT_FADE_END) / cell));
+  int top = std::max(
+      0, static_cast<int>((playerPos.y - HINT_FADE_END) / cell));
+  int right = std::min(textHintBucketsX - 1,
+                       static_cast<int>((playerPos.x + HINT_FADE_END) / cell));
+  int bottom = std::min(textHintBucketsY - 1,
+                        static_cast<int>((playerPos.y + HINT_FADE_END) / cell));
+
+  frameTextHints.clear();
+  for (int by = top; by <= bottom; ++by) {
+    for (int bx = left; bx <= right; ++bx) {
+      int bucket = by * textHintBucketsX + bx;
+      for (uint32_t i = textHintBucketStart[bucket];
+           i < textHintBucketStart[bucket + 1]; ++i) {
+        uint32_t index = textHintBucketItems[i];
+        const TextHint &hint = textHints[index];
+
+        // Visit each hint only from the first bucket it shares with the query
+        int firstX = std::max(
+            static_cast<int>(hint.bounds.position.x / cell), left);
+        int firstY = std::max(
+            static_cast<int>(hint.bounds.position.y / cell), top);
+        if (firstX != bx || firstY != by)
+          continue;
+        if (!view.findIntersection(hint.bounds))
+          continue;
 
-  for (const auto &layer : layers) {
-    const auto &grid = layer.grid;
-    for (int y = top_tile; y <= bottom_tile; ++y) {
-      for (int x = left_tile; x <= right_tile; ++x) {
-        if (y >= 0 && y < grid.size() && x >= 0 && x < grid[y].size()) {
-          uint32_t rawId = grid[y][x];
-          if (rawId != 0) {
-            int id = static_cast<int>(rawId & TILE_MASK);
-            const TilesetInfo *ts = getTilesetForId(id);
-            if (ts && (ts->name == "ts_main" || ts->name == "MainTileset")) {
-              int localId = id - ts->firstgid;
-              int functionalId = localId % ts->columns;
-
-              if (functionalId == TileType::Wall) {
-                collisions.push_back(sf::FloatRect(
-                    {x * TILE_SIZE, y * TILE_SIZE}, {TILE_SIZE, TILE_SIZE}));
-              }
-            }
-          }
+        // Proximity fade: fully visible within HINT_FADE_START, invisible
+        // beyond HINT_FADE_END
+        sf::Vector2f d = hint.bounds.getCenter() - playerPos;
+        float distSq = d.x * d.x + d.y * d.y;
+        uint8_t alpha = 0;
+        if (distSq < HINT_FADE_START * HINT_FADE_START) {
+          alpha = 255;
+        } else if (distSq < HINT_FADE_END * HINT_FADE_END) {
+          float t = (std::sqrt(distSq) - HINT_FADE_START) /
+                    (HINT_FADE_END - HINT_FADE_START);
+          alpha = static_cast<uint8_t>(255.f * (1.f - t));
         }
+        if (alpha == 0)
+          continue;
+        frameTextHints.emplace_back(index, alpha);
+      }
+    }
+  }
+
+  // Rebuild this view's batch only when its hints or fade levels change
+  std::sort(frameTextHints.begin(), frameTextHints.end());
+  bool changed = frameTextHints.size() != hints.visible.size();
+  for (size_t i = 0; !changed && i < frameTextHints.size(); ++i)
+    changed = frameTextHints[i].first != hints.visible[i] ||
+              frameTextHints[i].second != hints.alphas[i];
+  if (changed) {
+    hints.visible.clear();
+    hints.alphas.clear();
+    for (const auto &[index, alpha] : frameTextHints) {
+      hints.visible.push_back(index);
+      hints.alphas.push_back(alpha);
+    }
+    dirty = true;
+  }
+
+  // Merge the visible hints into one vertex array (map order, so overlapping
+  // hints stack as before)
+  if (dirty) {
+    hints.batch.clear();
+    for (size_t i = 0; i < hints.visible.size(); ++i) {
+      const TextHint &hint = textHints[hints.visible[i]];
+      for (uint32_t v = hint.firstVertex;
+           v < hint.firstVertex + hint.vertexCount; ++v) {
+        sf::Vertex vertex = textHintVertices[v];
+        vertex.color.a = hints.alphas[i];
+        hints.batch.append(vertex);
       }
     }
   }
 
-  return collisions;
+  if (hints.batch.getVertexCount() > 0) {
+    sf::RenderStates states;
+    states.texture = &font->getTexture(HINT_CHARACTER_SIZE);
+    target.draw(hints.batch, states);
+  }
+}
+
+bool Map::getTileRange(const sf::FloatRect &bounds, int &left, int &top,
+                       int &right, int &bottom) const {
+  if (collisionGrid.empty())
+    return false;
+
+  left = std::max(0, static_cast<int>(bounds.position.x / TILE_SIZE));
+  top = std::max(0, static_cast<int>(bounds.position.y / TILE_SIZE));
+  right = std::min(
+      widthInTiles - 1,
+      static_cast<int>((bounds.position.x + bounds.size.x) / TILE_SIZE));
+  bottom = std::min(
+      heightInTiles - 1,
+      static_cast<int>((bounds.position.y + bounds.size.y) / TILE_SIZE));
+
+  return left <= right && top <= bottom;
+}
+
+bool Map::hasCollision(const sf::FloatRect &bounds) const {
+  int left, top, right, bottom;
+  if (!getTileRange(bounds, left, top, right, bottom))
+    return false;
+
+  return anyInSpan(CollisionWall, left, top, right, bottom);
+}
+
+bool Map::anyInSpan(uint8_t flag, int left, int top, int right,
+                    int bottom) const {
+  const std::vector<uint64_t> *bits = nullptr;
+  if (flag == CollisionWall)
+    bits = &solidBits;
+  else if (flag == CollisionPlatform)
+    bits = &platformBits;
+  else if (flag == CollisionSpikes)
+    bits = &hazardBits;
+  if (!bits || bits->empty())
+    return false;
+
+  left = std::max(left, 0);
+  top = std::max(top, 0);
+  right = std::min(right, widthInTiles - 1);
+  bottom = std::min(bottom, heightInTiles - 1);
+  if (left > right || top > bottom)
+    return false;
+
+  int firstWord = left >> 6;
+  int lastWord = right >> 6;
+  uint64_t firstMask = ~uint64_t{0} << (left & 63);
+  uint64_t lastMask = ~uint64_t{0} >> (63 - (right & 63));
+  if (firstWord == lastWord)
+    firstMask &= lastMask;
+
+  for (int y = top; y <= bottom; ++y) {
+    const uint64_t *row = &(*bits)[static_cast<size_t>(y) * bitboardWords];
+    if (row[firstWord] & firstMask)
+      return true;
+    if (firstWord == lastWord)
+      continue;
+    for (int w = firstWord + 1; w < lastWord; ++w) {
+      if (row[w])
+        return true;
+    }
+    if (row[lastWord] & lastMask)
+      return true;
+  }
+  return false;
 }
 
 bool Map::checkFinish(const sf::FloatRect &bounds) const {
@@ -753,103 +1022,327 @@ bool Map::checkFinish(const sf::FloatRect &bounds) const {
   return false;
 }
 
-std::vector<sf::FloatRect>
-Map::checkPlatformCollision(const sf::FloatRect &bounds) const {
-  std::vector<sf::FloatRect> platforms;
-
-  // Calculate tile range to check
-  int left_tile = static_cast<int>(bounds.position.x / TILE_SIZE);
-  int top_tile = static_cast<int>(bounds.position.y / TILE_SIZE);
-  int right_tile =
-      static_cast<int>((bounds.position.x + bounds.size.x) / TILE_SIZE);
-  int bottom_tile =
-      static_cast<int>((bounds.position.y + bounds.size.y) / TILE_SIZE);
-
-  // Clamp to map bounds
-  if (left_tile < 0)
-    left_tile = 0;
-  if (top_tile < 0)
-    top_tile = 0;
-  if (layers.empty() || layers[0].grid.empty())
-    return platforms;
-  if (right_tile >= static_cast<int>(layers[0].grid[0].size()))
-    right_tile = static_cast<int>(layers[0].grid[0].size()) - 1;
-  if (bottom_tile >= static_cast<int>(layers[0].grid.size()))
-    bottom_tile = static_cast<int>(layers[0].grid.size()) - 1;
+sf::FloatRect Map::getSweptBounds(const sf::FloatRect &bounds,
+                                  sf::Vector2f delta) {
+  sf::FloatRect area = bounds;
+  area.position.x += std::min(delta.x, 0.f);
+  area.position.y += std::min(delta.y, 0.f);
+  area.size.x += std::abs(delta.x);
+  area.size.y += std::abs(delta.y);
+  return area;
+}
 
-  for (const auto &layer : layers) {
-    const auto &grid = layer.grid;
-    for (int y = top_tile; y <= bottom_tile; ++y) {
-      for (int x = left_tile; x <= right_tile; ++x) {
-        if (y >= 0 && y < grid.size() && x >= 0 && x < grid[y].size()) {
-          uint32_t rawId = grid[y][x];
-          if (rawId != 0) {
-            int id = static_cast<int>(rawId & TILE_MASK);
-            const TilesetInfo *ts = getTilesetForId(id);
-            if (ts && (ts->name == "ts_main" || ts->name == "MainTileset")) {
-              int localId = id - ts->firstgid;
-              int functionalId = localId % ts->columns;
-
-              // Platform IDs
-              if (functionalId == TileType::Platform) {
-                platforms.push_back(sf::FloatRect(
-                    {x * TILE_SIZE, y * TILE_SIZE}, {TILE_SIZE, TILE_SIZE}));
-              }
-            }
-          }
-        }
-      }
+Map::SweepHit Map::sweep(const sf::FloatRect &bounds, sf::Vector2f delta,
+                         uint8_t mask) const {
+  SweepHit best;
+
+  int left, top, right, bottom;
+  if (!getTileRange(getSweptBounds(bounds, delta), left, top, right, bottom))
+    return best;
+
+  forEachCollider(left, top, right, bottom, mask, [&](const Collider &c) {
+    sweepCollider(bounds, delta, c, best);
+  });
+  return best;
+}
+
+void Map::sweepCollider(const sf::FloatRect &bounds, sf::Vector2f delta,
+                        const Collider &collider, SweepHit &best) {
+  const float inf = std::numeric_limits<float>::infinity();
+  sf::FloatRect c = collider.getBounds();
+  bool isPlatform = !(collider.flags & CollisionWall);
+
+  // One-way platforms only block falling onto their top surface
+  if (isPlatform && delta.y <= 0.f)
+    return;
+
+  // Entry/exit times along one axis (slab test). Returns false if the boxes
+  // can never overlap on that axis during the move.
+  auto axisTimes = [&](float boxMin, float boxSize, float cMin, float cSize,
+                       float d, float allowedDepth, float &entry,
+                       float &exit) {
+    float boxMax = boxMin + boxSize;
+    float cMax = cMin + cSize;
+    if (d == 0.f) {
+      if (boxMax <= cMin + SWEEP_SKIN || boxMin >= cMax - SWEEP_SKIN)
+        return false;
+      entry = -inf;
+      exit = inf;
+      return true;
     }
+
+    float gap = (d > 0.f) ? cMin - boxMax : boxMin - cMax;
+    float travel = std::abs(d);
+    entry = (gap >= -allowedDepth) ? std::max(gap, 0.f) / travel : -inf;
+    exit = ((d > 0.f) ? cMax - boxMin : boxMax - cMin) / travel;
+    return exit > 0.f;
+  };
+
+  float entryX, exitX, entryY, exitY;
+  if (!axisTimes(bounds.position.x, bounds.size.x, c.position.x, c.size.x,
+                 delta.x, SWEEP_SKIN, entryX, exitX))
+    return;
+  if (!axisTimes(bounds.position.y, bounds.size.y, c.position.y, c.size.y,
+                 delta.y, isPlatform ? PLATFORM_TOLERANCE : SWEEP_SKIN,
+                 entryY, exitY))
+    return;
+
+  float entry = std::max(entryX, entryY);
+  float exit = std::min(exitX, exitY);
+
+  // Already overlapping on both axes: ignore so the entity can move out
+  if (entry == -inf || entry > exit || entry >= 1.f)
+    return;
+
+  bool verticalContact = entryY >= entryX;
+  if (isPlatform) {
+    // Must land on the top, with enough of the box resting on the platform
+    if (!verticalContact)
+      return;
+    float xAtContact = bounds.position.x + delta.x * entry;
+    float overlapX = std::min(xAtContact + bounds.size.x,
+                              c.position.x + c.size.x) -
+                     std::max(xAtContact, c.position.x);
+    if (overlapX < PLATFORM_MIN_OVERLAP)
+      return;
   }
 
-  return platforms;
+  if (best.hit) {
+    if (entry > best.time)
+      return;
+    if (entry == best.time && (!verticalContact || best.normal.y != 0.f))
+      return;
+  }
+
+  best.hit = true;
+  best.time = entry;
+  best.normal = verticalContact ? sf::Vector2f(0.f, delta.y > 0.f ? -1.f : 1.f)
+                                : sf::Vector2f(delta.x > 0.f ? -1.f : 1.f, 0.f);
+  best.collider = c;
+  best.flags = collider.flags;
+}
+
+Map::RayHit Map::raycast(sf::Vector2f origin, sf::Vector2f direction,
+                         float maxDistance, uint8_t mask) const {
+  RayHit result;
+
+  float length = std::hypot(direction.x, direction.y);
+  if (length == 0.f || maxDistance < 0.f || collisionGrid.empty())
+    return result;
+  sf::Vector2f dir = direction / length;
+
+  // Clip the ray to the map area; everything outside counts as empty
+  float tEnter = 0.f;
+  float tExit = maxDistance;
+  auto clip = [&](float o, float d, float size) {
+    if (d == 0.f)
+      return o >= 0.f && o < size;
+    float t0 = -o / d;
+    float t1 = (size - o) / d;
+    if (t0 > t1)
+      std::swap(t0, t1);
+    tEnter = std::max(tEnter, t0);
+    tExit = std::min(tExit, t1);
+    return tEnter <= tExit;
+  };
+  if (!clip(origin.x, dir.x, getWidth()) || !clip(origin.y, dir.y, getHeight()))
+    return result;
+
+  // Starting cell (clamped, the entry point may sit on the far map edge)
+  sf::Vector2f start = origin + dir * tEnter;
+  int x = std::clamp(static_cast<int>(std::floor(start.x / TILE_SIZE)), 0,
+                     widthInTiles - 1);
+  int y = std::clamp(static_cast<int>(std::floor(start.y / TILE_SIZE)), 0,
+                     heightInTiles - 1);
+
+  // Step direction, distance to the next cell boundary and distance between
+  // boundaries on each axis (all measured along the ray from origin)
+  const float inf = std::numeric_limits<float>::infinity();
+  int stepX = (dir.x > 0.f) ? 1 : -1;
+  int stepY = (dir.y > 0.f) ? 1 : -1;
+  float deltaX = (dir.x != 0.f) ? TILE_SIZE / std::abs(dir.x) : inf;
+  float deltaY = (dir.y != 0.f) ? TILE_SIZE / std::abs(dir.y) : inf;
+  float nextX = inf;
+  float nextY = inf;
+  if (dir.x != 0.f)
+    nextX = ((x + (stepX > 0 ? 1 : 0)) * TILE_SIZE - origin.x) / dir.x;
+  if (dir.y != 0.f)
+    nextY = ((y + (stepY > 0 ? 1 : 0)) * TILE_SIZE - origin.y) / dir.y;
+
+  float t = tEnter;
+  while (true) {
+    if (collisionGrid[y * widthInTiles + x] & mask) {
+      result.hit = true;
+      result.cell = {x, y};
+      result.point = origin + dir * t;
+      result.distance = t;
+      return result;
+    }
+
+    // Advance to whichever cell boundary comes first
+    if (nextX < nextY) {
+      t = nextX;
+      x += stepX;
+      nextX += deltaX;
+    } else {
+      t = nextY;
+      y += stepY;
+      nextY += deltaY;
+    }
+
+    if (t > tExit || x < 0 || y < 0 || x >= widthInTiles ||
+        y >= heightInTiles)
+      return result;
+  }
+}
+
+void Map::raycast(std::span<const Ray> rays, std::span<RayHit> hits,
+                  uint8_t mask) const {
+  size_t count = std::min(rays.size(), hits.size());
+  for (size_t i = 0; i < count; ++i)
+    hits[i] = raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance,
+                      mask);
+}
+
+bool Map::hasLineOfSight(sf::Vector2f from, sf::Vector2f to,
+                         uint8_t mask) const {
+  sf::Vector2f delta = to - from;
+  float distance = std::hypot(delta.x, delta.y);
+  if (distance == 0.f)
+    return !(getCollisionAt(static_cast<int>(std::floor(from.x / TILE_SIZE)),
+                            static_cast<int>(std::floor(from.y / TILE_SIZE))) &
+             mask);
+  return !raycast(from, delta, distance, mask).hit;
+}
+
+sf::FloatRect Map::getSpikeBounds(int x, int y) const {
+  sf::FloatRect spikeBounds({x * TILE_SIZE, y * TILE_SIZE},
+                            {TILE_SIZE, TILE_SIZE});
+
+  const TileProperties &props = getTilePropertiesAt(x, y);
+  spikeBounds.position.x += props.hazardInsetX;
+  spikeBounds.size.x -= 2.f * props.hazardInsetX;
+  spikeBounds.position.y += props.hazardInsetTop;
+  spikeBounds.size.y -= props.hazardInsetTop;
+  return spikeBounds;
 }
 
 bool Map::checkSpikeCollision(const sf::FloatRect &bounds) const {
-  int left_tile = static_cast<int>(bounds.position.x / TILE_SIZE);
-  int top_tile = static_cast<int>(bounds.position.y / TILE_SIZE);
-  int right_tile =
-      static_cast<int>((bounds.position.x + bounds.size.x) / TILE_SIZE);
-  int bottom_tile =
-      static_cast<int>((bounds.position.y + bounds.size.y) / TILE_SIZE);
-
-  if (left_tile < 0)
-    left_tile = 0;
-  if (top_tile < 0)
-    top_tile = 0;
-  if (layers.empty() || layers[0].grid.empty())
+  int left, top, right, bottom;
+  if (!getTileRange(bounds, left, top, right, bottom))
     return false;
-  if (right_tile >= static_cast<int>(layers[0].grid[0].size()))
-    right_tile = static_cast<int>(layers[0].grid[0].size()) - 1;
-  if (bottom_tile >= static_cast<int>(layers[0].grid.size()))
-    bottom_tile = static_cast<int>(layers[0].grid.size()) - 1;
 
-  for (const auto &layer : layers) {
-    const auto &grid = layer.grid;
-    for (int y = top_tile; y <= bottom_tile; ++y) {
-      for (int x = left_tile; x <= right_tile; ++x) {
-        if (y >= 0 && y < grid.size() && x >= 0 && x < grid[y].size()) {
-          uint32_t rawId = grid[y][x];
-          if (rawId != 0) {
-            int id = static_cast<int>(rawId & TILE_MASK);
-            const TilesetInfo *ts = getTilesetForId(id);
-            if (ts && (ts->name == "ts_main" || ts->name == "MainTileset")) {
-              int localId = id - ts->firstgid;
-              int functionalId = localId % ts->columns;
-
-              if (functionalId == TileType::Spikes) {
-                sf::FloatRect spikeBounds({x * TILE_SIZE, y * TILE_SIZE},
-                                          {TILE_SIZE, TILE_SIZE});
-
-                spikeBounds.position.x += 4.f;
-                spikeBounds.size.x -= 8.f;
-                spikeBounds.position.y += 10.f;
-                spikeBounds.size.y -= 10.f;
-
-                if (bounds.findIntersection(spikeBounds).has_value()) {
-                  return true;
-                }
-              }
+  // Cheap rejection: no hazard cell anywhere in the span
+  if (!anyInSpan(CollisionSpikes, left, top, right, bottom))
+    return false;
+
+  for (int y = top; y <= bottom; ++y) {
+    const uint8_t *row = &collisionGrid[y * widthInTiles];
+    for (int x = left; x <= right; ++x) {
+      if ((row[x] & CollisionSpikes) &&
+          bounds.findIntersection(getSpikeBounds(x, y)).has_value()) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void Map::buildChunks() {
+  chunks.clear();
+  occludedTiles = 0;
+  chunksX = (widthInTiles + CHUNK_TILES - 1) / CHUNK_TILES;
+  chunksY = (heightInTiles + CHUNK_TILES - 1) / CHUNK_TILES;
+  chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+
+  // Animated tiles in build order, with their animation
+  std::vector<std::pair<int, AnimatedTile>> animated;
+
+  for (int cy = 0; cy < chunksY; ++cy) {
+    for (int cx = 0; cx < chunksX; ++cx) {
+      Chunk &chunk = chunks[cy * chunksX + cx];
+      int startX = cx * CHUNK_TILES;
+      int startY = cy * CHUNK_TILES;
+
+      // Topmost layer with an opaque tile in each cell of the chunk. Tiles
+      // on lower layers of that cell are never visible.
+      std::array<int, CHUNK_TILES * CHUNK_TILES> coverLayer;
+      coverLayer.fill(-1);
+      for (size_t li = 0; li < layers.size(); ++li) {
+        const Layer &layer = layers[li];
+        int endX = std::min({startX + CHUNK_TILES, layer.width, widthInTiles});
+        int endY =
+            std::min({startY + CHUNK_TILES, layer.height, heightInTiles});
+        for (int y = startY; y < endY; ++y) {
+          for (int x = startX; x < endX; ++x) {
+            int id = layer.tileAt(x, y);
+            if (id < static_cast<int>(tileOccludesById.size()) &&
+                tileOccludesById[id])
+              coverLayer[(y - startY) * CHUNK_TILES + (x - startX)] =
+                  static_cast<int>(li);
+          }
+        }
+      }
+
+      for (size_t li = 0; li < layers.size(); ++li) {
+        const Layer &layer = layers[li];
+        int endX = std::min({startX + CHUNK_TILES, layer.width, widthInTiles});
+        int endY =
+            std::min({startY + CHUNK_TILES, layer.height, heightInTiles});
+
+        for (int y = startY; y < endY; ++y) {
+          for (int x = startX; x < endX; ++x) {
+            int id = layer.tileAt(x, y);
+            if (id == 0 || id >= static_cast<int>(tilesetIndexById.size()) ||
+                tilesetIndexById[id] < 0)
+              continue;
+
+            // Animated tiles start with the current frame of their animation
+            int animation = animationById[id];
+            const sf::IntRect &rect =
+                animation < 0
+                    ? textureRectById[id]
+                    : animations[animation]
+                          .frameRects[animations[animation].frame];
+
+            // Skip tiles hidden under an opaque tile, unless they spill
+            // over into the neighboring cells
+            if (static_cast<int>(li) <
+                    coverLayer[(y - startY) * CHUNK_TILES + (x - startX)] &&
+                rect.size.x <= TILE_SIZE && rect.size.y <= TILE_SIZE) {
+              occludedTiles++;
+              continue;
+            }
+
+            // Continue the last batch if the tile shares its texture,
+            // otherwise start a new one to keep the layer order
+            const TilesetInfo &ts = tilesets[tilesetIndexById[id]];
+            const sf::Texture *texture =
+                ts.atlasTexture ? ts.atlasTexture : &ts.texture;
+            if (chunk.batches.empty() ||
+                chunk.batches.back().texture != texture ||
+                chunk.batches.back().debugOnly != ts.debugOnly ||
+                (tileSpill > 0 &&
+                 chunk.batches.back().layer != static_cast<int>(li))) {
+              chunk.batches.emplace_back();
+              chunk.batches.back().texture = texture;
+              chunk.batches.back().debugOnly = ts.debugOnly;
+              chunk.batches.back().layer = static_cast<int>(li);
+            }
+
+            sf::VertexArray &vertices = chunk.batches.back().vertices;
+            size_t base = vertices.getVertexCount();
+            vertices.resize(base + 6);
+            writeTileQuad(&vertices[base], x, y, rect, layer.flipsAt(x, y));
+
+            if (animation >= 0) {
+              chunk.animated = true;
+              animated.push_back(
+                  {animation,
+                   {static_cast<uint32_t>(cy * chunksX + cx),
+                    static_cast<uint32_t>(chunk.batches.size() - 1),
+                    static_cast<uint32_t>(base), layer.flipsAt(x, y)}});
             }
           }
         }
@@ -857,21 +1350,416 @@ bool Map::checkSpikeCollision(const sf::FloatRect &bounds) const {
     }
   }
 
+  // Group the animated tiles by animation (counting sort)
+  animatedTileStart.assign(animations.size() + 1, 0);
+  for (const auto &[animation, tile] : animated)
+    animatedTileStart[animation + 1]++;
+  for (size_t i = 1; i < animatedTileStart.size(); ++i)
+    animatedTileStart[i] += animatedTileStart[i - 1];
+
+  animatedTiles.resize(animated.size());
+  std::vector<uint32_t> cursor(animatedTileStart.begin(),
+                               animatedTileStart.end() - 1);
+  for (const auto &[animation, tile] : animated)
+    animatedTiles[cursor[animation]++] = tile;
+}
+
+bool Map::hasVisualTiles(int cx, int cy) const {
+  if (cx < 0 || cy < 0 || cx >= chunksX || cy >= chunksY)
+    return false;
+
+  for (const auto &batch : chunks[cy * chunksX + cx].batches) {
+    if (!batch.debugOnly && batch.vertices.getVertexCount() > 0)
+      return true;
+  }
   return false;
 }
 
-const Map::TilesetInfo *Map::getTilesetForId(int globalId) const {
-  if (globalId < 0 || tilesets.empty())
-    return nullptr;
+bool Map::hasAnimatedTiles(int cx, int cy) const {
+  if (cx < 0 || cy < 0 || cx >= chunksX || cy >= chunksY)
+    return false;
+  return chunks[cy * chunksX + cx].animated;
+}
 
-  // Tilesets are usually sorted by firstgid
-  const TilesetInfo *bestMatch = nullptr;
-  for (const auto &ts : tilesets) {
-    if (globalId >= ts.firstgid) {
-      if (!bestMatch || ts.firstgid > bestMatch->firstgid) {
-        bestMatch = &ts;
+void Map::updateAnimations(sf::Time dt) {
+  if (animations.empty())
+    return;
+  animationTime += dt.asMicroseconds();
+  int64_t now = animationTime / 1000;
+
+  for (size_t a = 0; a < animations.size(); ++a) {
+    TileAnimation &animation = animations[a];
+    int loopTime = static_cast<int>(now % animation.frameEnds.back());
+    int frame = static_cast<int>(
+        std::upper_bound(animation.frameEnds.begin(),
+                         animation.frameEnds.end(), loopTime) -
+        animation.frameEnds.begin());
+    if (frame == animation.frame)
+      continue;
+
+    // Only the texture coordinates change, the static geometry stays
+    animation.frame = frame;
+    const sf::IntRect &rect = animation.frameRects[frame];
+    for (uint32_t i = animatedTileStart[a]; i < animatedTileStart[a + 1];
+         ++i) {
+      const AnimatedTile &tile = animatedTiles[i];
+      sf::VertexArray &vertices =
+          chunks[tile.chunk].batches[tile.batch].vertices;
+      writeTileTexCoords(&vertices[tile.firstVertex], rect, tile.flips);
+    }
+  }
+}
+
+void Map::drawChunk(sf::RenderTarget &target, int cx, int cy,
+                    const sf::RenderStates &states, bool drawVisual,
+                    bool drawDebug, int layer) const {
+  if (cx < 0 || cy < 0 || cx >= chunksX || cy >= chunksY)
+    return;
+
+  // One draw call per batch
+  sf::RenderStates batchStates = states;
+  for (const auto &batch : chunks[cy * chunksX + cx].batches) {
+    if (batch.debugOnly ? !drawDebug : !drawVisual)
+      continue;
+    if (layer >= 0 && batch.layer != layer)
+      continue;
+
+    batchStates.texture = batch.texture;
+    target.draw(batch.vertices, batchStates);
+  }
+}
+
+void Map::addToAtlas(TextureAtlas &atlas) {
+  for (auto &ts : tilesets) {
+    if (!ts.imageSource.empty())
+      ts.atlasId = atlas.add(ts.imageSource);
+  }
+}
+
+void Map::useAtlas(const TextureAtlas &atlas) {
+  for (auto &ts : tilesets) {
+    ts.atlasTexture = atlas.getTexture(ts.atlasId);
+    ts.atlasOrigin = ts.atlasTexture ? atlas.getRegion(ts.atlasId).rect.position
+                                     : sf::Vector2i();
+
+    // Upload the image on its own only if it did not fit into the atlas
+    if (ts.atlasTexture)
+      ts.texture = sf::Texture();
+    else if (!ts.imageSource.empty() && ts.texture.getSize().x == 0 &&
+             !ts.texture.loadFromFile(ts.imageSource))
+      std::cerr << "Failed to load tileset texture: " << ts.imageSource
+                << std::endl;
+  }
+
+  // Texture rects and chunk geometry depend on the atlas placement
+  buildTileLookup();
+  buildChunks();
+  chunkCache.clear();
+  chunkImpostors.clear();
+}
+
+void Map::setChunkCaching(bool enabled) {
+  // A flattened chunk would draw its large tiles over the lower layers of
+  // its neighbors and cut them off at the chunk edge
+  chunkCaching = enabled && !hasSpillingTiles();
+  if (!chunkCaching)
+    chunkCache.clear();
+}
+
+void Map::prefetchChunks(const sf::FloatRect &area) {
+  if (chunkCaching)
+    chunkCache.prefetch(*this, area);
+}
+
+void Map::writeTileQuad(sf::Vertex *quad, int x, int y,
+                        const sf::IntRect &textureRect, uint8_t flips) {
+  // Tiles are drawn at their texture size, anchored at the cell's
+  // bottom-left corner like Tiled does. A diagonal flip swaps the quad's
+  // width and height.
+  sf::Vector2f size(textureRect.size);
+  if (flips & CELL_FLIP_D)
+    std::swap(size.x, size.y);
+  sf::Vector2f topLeft(x * TILE_SIZE, (y + 1) * TILE_SIZE - size.y);
+
+  auto corner = [&](float u, float v) {
+    return sf::Vertex{{topLeft.x + u * size.x, topLeft.y + v * size.y},
+                      sf::Color::White};
+  };
+
+  quad[0] = corner(0.f, 0.f);
+  quad[1] = corner(1.f, 0.f);
+  quad[2] = corner(0.f, 1.f);
+  quad[3] = corner(0.f, 1.f);
+  quad[4] = corner(1.f, 0.f);
+  quad[5] = corner(1.f, 1.f);
+  writeTileTexCoords(quad, textureRect, flips);
+}
+
+void Map::writeTileTexCoords(sf::Vertex *quad, const sf::IntRect &textureRect,
+                             uint8_t flips) {
+  // Tiled applies the diagonal flip first, then horizontal, then vertical.
+  // Undo them in reverse to find which texture corner shows at (u, v).
+  auto texCoord = [&](float u, float v) {
+    if (flips & CELL_FLIP_V)
+      v = 1.f - v;
+    if (flips & CELL_FLIP_H)
+      u = 1.f - u;
+    if (flips & CELL_FLIP_D)
+      std::swap(u, v);
+    return sf::Vector2f(textureRect.position.x + u * textureRect.size.x,
+                        textureRect.position.y + v * textureRect.size.y);
+  };
+
+  quad[0].texCoords = texCoord(0.f, 0.f);
+  quad[1].texCoords = texCoord(1.f, 0.f);
+  quad[2].texCoords = texCoord(0.f, 1.f);
+  quad[3].texCoords = texCoord(0.f, 1.f);
+  quad[4].texCoords = texCoord(1.f, 0.f);
+  quad[5].texCoords = texCoord(1.f, 1.f);
+}
+
+bool Map::loadTilesetImage(TilesetInfo &ts) {
+  sf::Image image;
+  if (!image.loadFromFile(ts.imageSource))
+    return false;
+  ts.imageSize = image.getSize();
+
+  // A tile is opaque if none of its pixels is even slightly transparent
+  ts.opaqueTiles.clear();
+  if (ts.columns <= 0 || ts.tilewidth <= 0 || ts.tileheight <= 0)
+    return true;
+
+  sf::Vector2u imageSize = image.getSize();
+  int rows = static_cast<int>(imageSize.y) / ts.tileheight;
+  ts.opaqueTiles.assign(static_cast<size_t>(ts.columns) * rows, 0);
+  for (int localId = 0; localId < static_cast<int>(ts.opaqueTiles.size());
+       ++localId) {
+    unsigned left = (localId % ts.columns) * ts.tilewidth;
+    unsigned top = (localId / ts.columns) * ts.tileheight;
+    if (left + ts.tilewidth > imageSize.x)
+      continue;
+
+    bool opaque = true;
+    for (unsigned y = top; opaque && y < top + ts.tileheight; ++y) {
+      for (unsigned x = left; x < left + ts.tilewidth; ++x) {
+        if (image.getPixel({x, y}).a != 255) {
+          opaque = false;
+          break;
+        }
+      }
+    }
+    ts.opaqueTiles[localId] = opaque;
+  }
+  return true;
+}
+
+void Map::parseTileProperties(const std::string &tilesetContent,
+                              TilesetInfo &ts) {
+  // Tileset-level properties come before the first <tile>
+  size_t firstTile = tilesetContent.find("<tile ");
+  size_t propsStart = tilesetContent.find("<properties>");
+  if (propsStart != std::string::npos && propsStart < firstTile) {
+    size_t propsEnd = tilesetContent.find("</properties>", propsStart);
+    forEachProperty(
+        tilesetContent.substr(propsStart, propsEnd - propsStart),
+        [&](const std::string &name, const std::string &value) {
+          if (name == "debugOnly")
+            ts.debugOnly = (value == "true");
+        });
+  }
+
+  // Per-tile type (class in Tiled 1.9+) and custom properties
+  size_t pos = firstTile;
+  while (pos != std::string::npos) {
+    size_t tagEnd = tilesetContent.find(">", pos);
+    if (tagEnd == std::string::npos)
+      break;
+    std::string tag = tilesetContent.substr(pos, tagEnd - pos);
+    bool selfClosing = !tag.empty() && tag.back() == '/';
+    size_t blockEnd = selfClosing
+                          ? tagEnd
+                          : tilesetContent.find("</tile>", tagEnd);
+    pos = tilesetContent.find("<tile ", tagEnd);
+
+    std::string idStr = extractAttribute(tag, "id");
+    if (idStr.empty())
+      continue;
+    int localId = std::stoi(idStr);
+    if (localId < 0)
+      continue;
+
+    TileProperties props;
+    std::string type = extractAttribute(tag, "class");
+    if (type.empty())
+      type = extractAttribute(tag, "type");
+
+    if (!selfClosing && blockEnd != std::string::npos) {
+      std::string block = tilesetContent.substr(tagEnd, blockEnd - tagEnd);
+      forEachProperty(
+          block, [&](const std::string &name, const std::string &value) {
+            if (name == "type") {
+              type = value;
+            } else if (name == "friction") {
+              props.friction = std::strtof(value.c_str(), nullptr);
+            } else if (name == "restitution") {
+              props.restitution = std::strtof(value.c_str(), nullptr);
+            } else if (name == "hazardInsetX") {
+              props.hazardInsetX = static_cast<uint8_t>(
+                  std::clamp(std::atoi(value.c_str()), 0, 15));
+            } else if (name == "hazardInsetTop") {
+              props.hazardInsetTop = static_cast<uint8_t>(
+                  std::clamp(std::atoi(value.c_str()), 0, 31));
+            }
+          });
+
+      std::vector<AnimationFrame> frames = parseAnimationFrames(block);
+      if (!frames.empty()) {
+        if (localId >= static_cast<int>(ts.animations.size()))
+          ts.animations.resize(localId + 1);
+        ts.animations[localId] = std::move(frames);
+      }
+    }
+
+    if (!type.empty()) {
+      props.collision = collisionFlagFromType(type);
+      if (!props.collision)
+        std::cerr << "Warning: Unknown tile type '" << type << "' in tileset "
+                  << ts.name << std::endl;
+    }
+
+    if (localId >= static_cast<int>(ts.tileProperties.size()))
+      ts.tileProperties.resize(localId + 1);
+    ts.tileProperties[localId] = props;
+  }
+
+  applyLegacyTileTypes(ts);
+}
+
+void Map::applyLegacyTileTypes(TilesetInfo &ts) {
+  if (ts.name != "ts_main" && ts.name != "MainTileset")
+    return;
+  for (const auto &props : ts.tileProperties) {
+    if (props.collision)
+      return;
+  }
+  if (ts.columns <= 0 || ts.tileheight <= 0)
+    return;
+
+  std::cerr << "Warning: gameplay tileset " << ts.name
+            << " has no tile types; using the legacy column layout"
+            << std::endl;
+
+  // The gameplay markers are only drawn as a debug overlay
+  ts.debugOnly = true;
+
+  int count = ts.tilecount;
+  if (count <= 0)
+    count = ts.columns * static_cast<int>(ts.imageSize.y / ts.tileheight);
+  if (count > static_cast<int>(ts.tileProperties.size()))
+    ts.tileProperties.resize(count);
+  for (int localId = 0; localId < count; ++localId) {
+    int column = localId % ts.columns;
+    if (column < static_cast<int>(std::size(LEGACY_COLUMN_FLAGS)))
+      ts.tileProperties[localId].collision = LEGACY_COLUMN_FLAGS[column];
+  }
+}
+
+void Map::buildTileLookup() {
+  tilesetIndexById.clear();
+  textureRectById.clear();
+  tilePropertiesById.clear();
+  tileOccludesById.clear();
+  animationById.clear();
+  animations.clear();
+  animationTime = 0;
+  tileSpill = 0;
+
+  // Tiles of a tileset run from its firstgid up to the next tileset's firstgid
+  std::vector<int> order(tilesets.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = static_cast<int>(i);
+  std::sort(order.begin(), order.end(), [this](int a, int b) {
+    return tilesets[a].firstgid < tilesets[b].firstgid;
+  });
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    const TilesetInfo &ts = tilesets[order[i]];
+    if (ts.columns <= 0 || ts.tilewidth <= 0 || ts.tileheight <= 0)
+      continue;
+
+    int count = ts.tilecount;
+    if (count <= 0)
+      count = ts.columns *
+              static_cast<int>(ts.imageSize.y / ts.tileheight);
+    int endId = ts.firstgid + count;
+    if (i + 1 < order.size())
+      endId = std::min(endId, tilesets[order[i + 1]].firstgid);
+    endId = std::min(endId, static_cast<int>(UINT16_MAX) + 1);
+
+    if (endId > static_cast<int>(tilesetIndexById.size())) {
+      tilesetIndexById.resize(endId, -1);
+      textureRectById.resize(endId);
+      tilePropertiesById.resize(endId);
+      tileOccludesById.resize(endId, 0);
+      animationById.resize(endId, -1);
+    }
+
+    // Tiles are anchored at their cell's bottom-left corner, so larger ones
+    // reach past its right and top edges
+    tileSpill = std::max(tileSpill, std::max(ts.tilewidth, ts.tileheight) -
+                                        static_cast<int>(TILE_SIZE));
+
+    // Opaque tiles hide the cell below only if they cover all of it and are
+    // actually drawn in normal play
+    bool canOcclude = !ts.debugOnly && ts.tilewidth >= TILE_SIZE &&
+                      ts.tileheight >= TILE_SIZE;
+
+    auto localRect = [&](int localId) {
+      return sf::IntRect(
+          ts.atlasOrigin + sf::Vector2i((localId % ts.columns) * ts.tilewidth,
+                                        (localId / ts.columns) * ts.tileheight),
+          {ts.tilewidth, ts.tileheight});
+    };
+
+    for (int id = std::max(ts.firstgid, 1); id < endId; ++id) {
+      int localId = id - ts.firstgid;
+      tilesetIndexById[id] = static_cast<int16_t>(order[i]);
+      textureRectById[id] = localRect(localId);
+      if (localId < static_cast<int>(ts.tileProperties.size()))
+        tilePropertiesById[id] = ts.tileProperties[localId];
+      tileOccludesById[id] =
+          canOcclude && localId < static_cast<int>(ts.opaqueTiles.size()) &&
+          ts.opaqueTiles[localId];
+
+      if (localId >= static_cast<int>(ts.animations.size()) ||
+          ts.animations[localId].empty() || animations.size() >= INT16_MAX)
+        continue;
+
+      // Resolve the frames once, so switching frames is a rect copy
+      TileAnimation animation;
+      int loopTime = 0;
+      for (const auto &frame : ts.animations[localId]) {
+        if (frame.localId < 0 || frame.localId >= endId - ts.firstgid)
+          continue;
+        loopTime += frame.duration;
+        animation.frameRects.push_back(localRect(frame.localId));
+        animation.frameEnds.push_back(loopTime);
       }
+      if (animation.frameRects.empty())
+        continue;
+
+      // Other frames may not be opaque, so animated tiles never occlude
+      animationById[id] = static_cast<int16_t>(animations.size());
+      animations.push_back(std::move(animation));
+      tileOccludesById[id] = 0;
     }
   }
-  return bestMatch;
+}
+
+const Map::TilesetInfo *Map::getTilesetForId(int globalId) const {
+  if (globalId < 0 || globalId >= static_cast<int>(tilesetIndexById.size()))
+    return nullptr;
+
+  int index = tilesetIndexById[globalId];
+  return index < 0 ? nullptr : &tilesets[index];
 }
@@ -0,0 +1,48 @@
+#include <Game/World/TileNeighborhood.hpp>
+
+void TileNeighborhood::capture(const Map &map, const sf::FloatRect &area) {
+  this->map = &map;
+  count = 0;
+  valid = map.getTileRange(area, left, top, right, bottom);
+  if (!valid)
+    return;
+
+  map.forEachCollider(left, top, right, bottom,
+                      Map::CollisionWall | Map::CollisionPlatform,
+                      [this](const Map::Collider &c) {
+                        if (count < MAX_COLLIDERS)
+                          colliders[count] = c;
+                        ++count;
+                      });
+
+  // Too crowded to snapshot: answer everything from the map instead
+  if (count > MAX_COLLIDERS) {
+    valid = false;
+    count = 0;
+  }
+}
+
+bool TileNeighborhood::hasCollision(const sf::FloatRect &bounds) const {
+  // A span test on the map bitboards is cheaper than walking the snapshot
+  return map && map->hasCollision(bounds);
+}
+
+Map::SweepHit TileNeighborhood::sweep(const sf::FloatRect &bounds,
+                                      sf::Vector2f delta, uint8_t mask) const {
+  Map::SweepHit best;
+
+  int l, t, r, b;
+  if (!map ||
+      !map->getTileRange(Map::getSweptBounds(bounds, delta), l, t, r, b))
+    return best;
+
+  if (!covers(l, t, r, b))
+    return map->sweep(bounds, delta, mask);
+
+  for (int i = 0; i < count; ++i) {
+    const Map::Collider &c = colliders[i];
+    if ((c.flags & mask) && c.overlaps(l, t, r, b))
+      Map::sweepCollider(bounds, delta, c, best);
+  }
+  return best;
+}